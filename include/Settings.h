@@ -10,6 +10,40 @@
 #define BLUETOOTH_AT_BAUD_RATE 38400
 #define LIDAR_BAUD_RATE 115200
 
+/**
+ * Bluetooth module reprogramming. At startup the module is reprogrammed over AT commands to run 
+ * external communications at BLUETOOTH_TARGET_BAUD_RATE. Success is recorded in EEPROM so later 
+ * startups open the port directly.
+ */
+#define BLUETOOTH_WILL_RECONFIGURE_BAUD_RATE (true)
+#define BLUETOOTH_TARGET_BAUD_RATE 115200
+#define BLUETOOTH_AT_RESPONSE_TIMEOUT (300) // ms
+#define BLUETOOTH_AT_NUM_ATTEMPTS (2) // per candidate rate
+#define BLUETOOTH_KEY_SETTLE_TIME (100) // ms, after KEY raised before AT commands
+#define BLUETOOTH_RESET_TIME (1000) // ms, for module to restart into data mode
+#define BLUETOOTH_EEPROM_ADDRESS (0)
+#define BLUETOOTH_EEPROM_CONFIGURED_MARKER (0xB7)
+
+/**
+ * Internal link baud rate negotiation. Both boards start at INTERNAL_COMMS_BAUD_RATE, agree on the 
+ * fastest rate both support, and step down through the rates until one passes a test pattern 
+ * exchange. Either board falls back to INTERNAL_COMMS_BAUD_RATE if the link degrades.
+ */
+#define LINK_WILL_NEGOTIATE_BAUD_RATE (true)
+#define LINK_BAUD_RATE_INDEX_MAX (4) // fastest rate supported by this board, see LinkDefs.h
+#define LINK_TEST_PATTERN_LENGTH (8) // bytes
+#define LINK_TEST_NUM_EXCHANGES (8) // test patterns sent at each new rate
+#define LINK_TEST_NUM_EXCHANGES_TO_PASS (6) // first few may be lost while both boards switch
+#define LINK_TEST_PERIOD (25) // ms, between test patterns
+// ms, peripheral returns to base rate if not committed within, allows for one lost heartbeat
+#define LINK_TEST_TIMEOUT (LINK_TEST_NUM_EXCHANGES * LINK_TEST_PERIOD + 2 * LINK_HEARTBEAT_PERIOD)
+#define LINK_OFFER_PERIOD (500) // ms, between capability offers until accepted
+#define LINK_HEARTBEAT_PERIOD (200) // ms
+#define LINK_HEARTBEAT_TIMEOUT (1000) // ms, without heartbeat before falling back
+#define LINK_MONITOR_PERIOD (1000) // ms, between link error rate checks
+#define LINK_MONITOR_MIN_FRAMES (4) // frames within a period for error rate to be judged
+#define LINK_MONITOR_MAX_DROPPED_PERCENT (10) // above this the link falls back
+
 /*****************************************************
  *                      STRINGS                      *
  *****************************************************/
@@ -17,9 +51,9 @@
  * Break out buffer sizes by board
  */
 #if defined(BOARD_CONTROLLER)
-#define STRING_LENGTH_MAX 36
+#define STRING_LENGTH_MAX 37
 #elif defined(BOARD_PERIPHERAL)
-#define STRING_LENGTH_MAX 24
+#define STRING_LENGTH_MAX 25
 #else
 #error "Unsupported board! Please defined BOARD_xxx in platformio.ini"
 #endif
@@ -32,21 +66,84 @@
  */
 #if defined(BOARD_CONTROLLER)
 #define MESSAGE_NUM_BUFFERS 3 // ring buffer for raw comms interface
-#define MESSAGE_QUEUE_SIZE 3 // max number of stored messages for subsystems
+#define MESSAGE_QUEUE_SIZE 2 // default max number of stored messages per subsystem queue
+#define MESSAGE_POOL_SIZE 16 // messages shared by all subsystem queues
+#define COMMS_TX_BUFFER_SIZE 128 // bytes of encoded frames waiting to transmit
+#define TASKMASTER_COLLECT_BYTE_BUDGET 96 // max bytes of frames collected per loop
+#define TASKMASTER_RECEIVE_BYTE_BUDGET 128 // max bytes received per port per loop
+#define TASKMASTER_BULK_RESERVED_BYTES 36 // bytes of transmit buffer kept from Bulk frames
+#define TASKMASTER_NUM_PORTS_MAX 2 // host and peripheral board
+#define TASKMASTER_RELAY_QUEUE_SIZE 6 // messages for other boards waiting per port
+#define TASKMASTER_WILL_RELAY_FRAMES (true) // relay frames without decoding when possible
 #elif defined(BOARD_PERIPHERAL)
 #define MESSAGE_NUM_BUFFERS 2 // ring buffer for raw comms interface
-#define MESSAGE_QUEUE_SIZE 2 // max number of stored messages for subsystems
+#define MESSAGE_QUEUE_SIZE 2 // default max number of stored messages per subsystem queue
+#define MESSAGE_POOL_SIZE 8 // messages shared by all subsystem queues
+#define COMMS_TX_BUFFER_SIZE 48 // bytes of encoded frames waiting to transmit
+#define TASKMASTER_COLLECT_BYTE_BUDGET 48 // max bytes of frames collected per loop
+#define TASKMASTER_RECEIVE_BYTE_BUDGET 64 // max bytes received per port per loop
+#define TASKMASTER_BULK_RESERVED_BYTES 24 // bytes of transmit buffer kept from Bulk frames
+#define TASKMASTER_NUM_PORTS_MAX 1 // controller board
+#define TASKMASTER_RELAY_QUEUE_SIZE 1 // messages for other boards waiting per port
+#define TASKMASTER_WILL_RELAY_FRAMES (true) // relay frames without decoding when possible
 #else
 #error "Unsupported board! Please defined BOARD_xxx in platformio.ini"
 #endif
-// Each encoded message ends with this token
-#define MESSAGE_END_CHAR '$'
-// Each message includes encoding data of a (1) type char, (2) size char, and (3) end char
-#define MESSAGE_ENCODING_LENGTH (3)
+// Each message includes encoding data of a (1) type char and (2) size char
+#define MESSAGE_ENCODING_LENGTH (2)
 // Type char and size char are at beginning of message
 #define MESSAGE_PRE_ENCODE_LENGTH (2)
-// Each message allows space for encoding data and a null-terminator
-#define MESSAGE_CONTENT_LENGTH_MAX (STRING_LENGTH_MAX - MESSAGE_ENCODING_LENGTH - 1)
+// Each message allows space for encoding data, framing data and a null-terminator
+#define MESSAGE_CONTENT_LENGTH_MAX (STRING_LENGTH_MAX - MESSAGE_ENCODING_LENGTH - FRAME_ENCODING_LENGTH - 1)
+// Each unframed message is its encoding data and content
+#define MESSAGE_RAW_LENGTH_MAX (MESSAGE_ENCODING_LENGTH + MESSAGE_CONTENT_LENGTH_MAX)
+// Enum messages carry a single code char rather than a string, legacy strings are still accepted
+#define ENUM_WILL_SEND_CODES (true)
+
+/*****************************************************
+ *                      FRAMING                      *
+ *****************************************************/
+/**
+ * Every message is wrapped in a frame on the wire: the message bytes and a CRC-16 are COBS 
+ * byte-stuffed so no zero byte remains, then a zero delimiter closes the frame.
+ */
+// Each encoded frame ends with this token, which never appears inside a frame
+#define FRAME_DELIMITER_CHAR '\0'
+// CRC-16/CCITT-FALSE appended little-endian to each message before stuffing
+#define FRAME_CRC_LENGTH (2)
+#define FRAME_CRC_POLYNOMIAL (0x1021)
+#define FRAME_CRC_INIT (0xFFFF)
+// COBS adds one code byte for every 254 bytes stuffed, so one while frames fit a buffer
+#define FRAME_COBS_OVERHEAD_LENGTH (1)
+#define FRAME_DELIMITER_LENGTH (1)
+// Address char of destination and source board, one nibble each, ahead of the message bytes
+#define FRAME_ADDRESS_LENGTH (1)
+// Each frame includes framing data of a (1) address char, (2) CRC, (3) COBS code byte, and 
+// (4) delimiter
+#define FRAME_ENCODING_LENGTH ( \
+	FRAME_ADDRESS_LENGTH + FRAME_CRC_LENGTH + FRAME_COBS_OVERHEAD_LENGTH + FRAME_DELIMITER_LENGTH \
+)
+
+/*****************************************************
+ *                     ADDRESSES                     *
+ *****************************************************/
+/**
+ * Every board has an address. Frames carry the board they are for, so each board dispatches 
+ * frames addressed to itself and passes on the rest, hop by hop, by its Taskmaster's route table.
+ */
+#define BOARD_ADDRESS_HOST (0)
+#define BOARD_ADDRESS_CONTROLLER (1)
+#define BOARD_ADDRESS_PERIPHERAL (2)
+#define BOARD_ADDRESS_COUNT (3)
+#if defined(BOARD_CONTROLLER)
+#define BOARD_ADDRESS_SELF BOARD_ADDRESS_CONTROLLER
+#define BOARD_ADDRESS_LINK_PEER BOARD_ADDRESS_PERIPHERAL // other end of the negotiated link
+#elif defined(BOARD_PERIPHERAL)
+#define BOARD_ADDRESS_SELF BOARD_ADDRESS_PERIPHERAL
+#define BOARD_ADDRESS_LINK_PEER BOARD_ADDRESS_CONTROLLER // other end of the negotiated link
+#else
+#error "Unsupported board! Please defined BOARD_xxx in platformio.ini"
+#endif
 
 /*****************************************************
  *                   DRIVETRAIN                      *
@@ -56,26 +153,17 @@
  * 
  */
 #define DISTANCE_CENTER_TO_WHEEL_MIDPOINT_IN (3.569)
-#define WHEEL_DIAMETER_IN (2.20472)
-#define WHEEL_CIRCUMFERENCE_IN (2 * PI * WHEEL_DIAMETER_IN)
 
 /**
- * @brief Drivetrain encoder custom parameters
+ * @brief Wheel size and encoder gains (ENCODER_x_TO_IN) are in schema/messages.json, since the host
+ * scales DrivetrainEncoderTicks with them too. They are generated into lib/Message/MessageSchema.h.
  * 
  */
-#define DEFAULT_ENCODER_TICKS_PER_ROTATION (1000) // approx
-#define DEFAULT_ENCODER_GAIN_IN ((WHEEL_CIRCUMFERENCE_IN) / (DEFAULT_ENCODER_TICKS_PER_ROTATION))
-#define ENCODER_1_TUNING_GAIN ((float64_t)0.485)
-#define ENCODER_2_TUNING_GAIN ((float64_t)0.485)
-#define ENCODER_3_TUNING_GAIN ((float64_t)1.045)
-
-#define ENCODER_1_TO_IN (DEFAULT_ENCODER_GAIN_IN * ENCODER_1_TUNING_GAIN)
-#define ENCODER_2_TO_IN (DEFAULT_ENCODER_GAIN_IN * ENCODER_2_TUNING_GAIN)
-#define ENCODER_3_TO_IN (DEFAULT_ENCODER_GAIN_IN * ENCODER_3_TUNING_GAIN)
-
 #define ENCODER_WILL_VOLUNTEER_READINGS (false)
 #define ENCODER_TIME_TO_SEND_AFTER_LAST_SENT_DISTANCES (250UL) // millis
 
+#define DRIVETRAIN_WILL_SEND_FIXED_POINT (true) // send ticks and fixed-point values for the host to scale
+
 /**
  * @brief Drivetrain control custom parameters
  * 
@@ -186,6 +274,16 @@
 #define LIDAR_SWEEP_TIMEOUT_MS (1500UL) // millis
 #define LIDAR_RESET_TIME_MS (2000UL) // millis
 
+/**
+ * @brief LiDAR transmission custom parameters
+ * 
+ */
+#define LIDAR_SCAN_CHUNK_MAX_UNCOLLECTED (4) // uncollected points in a row before starting new chunk
+#define LIDAR_WILL_USE_COMPACT_SCAN_ENCODING (true) // delta/varint distances with 4-bit quality
+#define LIDAR_WILL_SEND_DELTA_SCANS (true) // only send points changed since last scan sent
+#define LIDAR_DELTA_SCAN_THRESHOLD_IN (2) // inches, changes up to this are not sent
+#define LIDAR_DELTA_SCAN_KEYFRAME_PERIOD (10) // scans, every Xth scan is sent in full
+
 /*****************************************************
  *                     ULTRASONIC                    *
  *****************************************************/
@@ -210,4 +308,15 @@
 #define GRIPPER_WRIST_REST_POS (135)
 #define GRIPPER_WRIST_CLOSED_POS (170)
 #define SERVO_STEP_INCREMENT (2) // 0 to 255
-#define SERVO_STEP_DELAY (20) // millis
\ No newline at end of file
+#define SERVO_STEP_DELAY (20) // millis
+
+/*****************************************************
+ *                    DIAGNOSTICS                    *
+ *****************************************************/
+
+#define DIAGNOSTICS_WILL_REPORT_LOOP_TIME (true)
+#define DIAGNOSTICS_LOOP_TIME_REPORT_PERIOD (5000) // millis
+#define LOOP_TIME_HISTOGRAM_NUM_BUCKETS (12)
+#define LOOP_TIME_HISTOGRAM_FIRST_BUCKET_SHIFT (9) // first bucket below 2^9 micros, each doubles
+#define DIAGNOSTICS_WILL_REPORT_COUNTERS (true)
+#define DIAGNOSTICS_COUNTERS_REPORT_PERIOD (5000) // millis
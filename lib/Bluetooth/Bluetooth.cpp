@@ -0,0 +1,137 @@
+#include <EEPROM.h>
+#include "MemoryUtilities.h"
+#include "Bluetooth.h"
+
+/**
+ * @brief Initialize a Bluetooth module
+ * 
+ * @param port Serial port connected to module
+ * @param pinKey Pin driving module KEY (EN), held high to enter AT command mode
+ */
+void Bluetooth::init(HardwareSerial* port, uint8_t pinKey)
+{
+	this->port = port;
+	this->pinKey = pinKey;
+
+	pinMode(pinKey, OUTPUT);
+	digitalWrite(pinKey, LOW);
+}
+
+/**
+ * @brief Send an AT command and wait for the module to acknowledge it
+ * 
+ * @param command Without line ending
+ * @return Whether the module responded OK within BLUETOOTH_AT_RESPONSE_TIMEOUT
+ */
+bool Bluetooth::sendCommand(const char* command)
+{
+	// Discard anything stale
+	while (port->available()) port->read();
+
+	port->print(command);
+	port->print("\r\n");
+
+	// Read one response line
+	char response[STRING_LENGTH_MAX];
+	size_t length = 0;
+	time_ms startTime = millis();
+	while ((millis() - startTime) < BLUETOOTH_AT_RESPONSE_TIMEOUT)
+	{
+		if (!port->available()) continue;
+
+		char here = port->read();
+		if (here == '\n') break;
+		if ((here != '\r') && (length < STRING_LENGTH_MAX - 1))
+			response[length++] = here;
+	}
+	response[length] = '\0';
+
+	return stringsEqual(response, "OK");
+}
+
+/**
+ * @brief Reopen the port at each rate the module may be listening to AT commands at, until it 
+ * responds
+ * 
+ * @return Whether the module responded
+ */
+bool Bluetooth::findCommandModeBaud(void)
+{
+	const unsigned long candidates[] = { 
+		BLUETOOTH_AT_BAUD_RATE, 
+		EXTERNAL_COMMS_BAUD_RATE, 
+		BLUETOOTH_TARGET_BAUD_RATE 
+	};
+
+	for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++)
+	{
+		port->end();
+		port->begin(candidates[i]);
+		for (uint8_t attempt = 0; attempt < BLUETOOTH_AT_NUM_ATTEMPTS; attempt++)
+			if (this->sendCommand("AT")) return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Determine if the module was already reprogrammed to a rate on an earlier startup
+ * 
+ * @param baud 
+ */
+bool Bluetooth::isConfigured(unsigned long baud)
+{
+	BluetoothConfiguredRecord record;
+	EEPROM.get(BLUETOOTH_EEPROM_ADDRESS, record);
+	return (
+		(record.marker == BLUETOOTH_EEPROM_CONFIGURED_MARKER) &&
+		(record.baud == baud)
+	);
+}
+
+/**
+ * @brief Record that the module was reprogrammed to a rate
+ * 
+ * @param baud 
+ */
+void Bluetooth::markConfigured(unsigned long baud)
+{
+	BluetoothConfiguredRecord record = { BLUETOOTH_EEPROM_CONFIGURED_MARKER, (uint32_t)baud };
+	EEPROM.put(BLUETOOTH_EEPROM_ADDRESS, record);
+}
+
+/**
+ * @brief Reprogram the module UART to a rate, unless already done on an earlier startup. The 
+ * module is left in data mode.
+ * 
+ * @param baud Desired rate
+ * @return Rate the module now communicates at, EXTERNAL_COMMS_BAUD_RATE if it could not be 
+ * reprogrammed
+ */
+unsigned long Bluetooth::configure(unsigned long baud)
+{
+	if (this->isConfigured(baud))
+		return baud;
+
+	// Enter AT command mode
+	digitalWrite(pinKey, HIGH);
+	delay(BLUETOOTH_KEY_SETTLE_TIME);
+
+	char command[STRING_LENGTH_MAX];
+	format(command, "AT+UART=%lu,0,0", baud);
+	bool isReprogrammed = (
+		this->findCommandModeBaud() &&
+		this->sendCommand(command)
+	);
+
+	// Restart into data mode, applying new rate. KEY must be low by the time the module boots.
+	this->sendCommand("AT+RESET");
+	digitalWrite(pinKey, LOW);
+	delay(BLUETOOTH_RESET_TIME);
+	port->end();
+
+	if (false == isReprogrammed)
+		return EXTERNAL_COMMS_BAUD_RATE;
+
+	this->markConfigured(baud);
+	return baud;
+}
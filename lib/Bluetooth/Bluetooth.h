@@ -0,0 +1,32 @@
+#pragma once
+#include "Settings.h"
+#include "Types.h"
+
+/**
+ * Record kept in EEPROM once the module has been reprogrammed, so later startups skip AT mode
+ */
+struct __attribute__((packed)) BluetoothConfiguredRecord
+{
+	uint8_t marker; // BLUETOOTH_EEPROM_CONFIGURED_MARKER once written
+	uint32_t baud; // rate the module was reprogrammed to
+};
+
+/**
+ * HC-05-style Bluetooth module, reprogrammed over AT commands to a faster UART rate
+ */
+class Bluetooth
+{
+private:
+	HardwareSerial* port;
+	uint8_t pinKey;
+
+	bool sendCommand(const char* command);
+	bool findCommandModeBaud(void);
+	bool isConfigured(unsigned long baud);
+	void markConfigured(unsigned long baud);
+
+public:
+	Bluetooth(void) {};
+	void init(HardwareSerial* port, uint8_t pinKey);
+	unsigned long configure(unsigned long baud);
+};
@@ -16,6 +16,19 @@ void Comms::init(HardwareSerial* port, unsigned long baud)
 	} // Allow time for Serial to connect
 }
 
+/**
+ * @brief Change the baud rate of the Serial port. Anything pending is transmitted at the current 
+ * rate first.
+ * 
+ * @param baud 
+ */
+void Comms::setBaud(unsigned long baud)
+{
+	port->flush();
+	port->end();
+	port->begin(baud);
+}
+
 /**
  * @brief Send a general buffer of information over the communication interface
  * 
@@ -28,28 +41,27 @@ void Comms::sendInfo(const char* buffer, size_t size)
 }
 
 /**
- * @brief Receive information from the communication interface
- * 
- * @param buffer Buffer to store received information in
- * @param length Length of buffer, including null-terminator
+ * @brief Get the number of bytes sendInfo accepts without blocking
  * 
- * @return Number of received bytes
+ * @return Number of bytes
  */
-size_t Comms::receiveInfo(char* buffer, size_t length)
+size_t Comms::getNumWritableBytes(void)
 {
-	size_t maxBytes = length - 1; // space for null_terminator
-	size_t availableBytes = this->get_num_unread_bytes();
-	size_t bytesToRead = min(maxBytes, availableBytes);
-
-	// Loop through available bytes
-	size_t i;
-	for(i = 0; i < bytesToRead; i++)
-	{
-		buffer[i] = this->read_byte();
-	}
+	return this->get_num_writable_bytes();
+}
 
-	// Add null terminator
-	buffer[i] = '\0';
+/**
+ * @brief Receive one byte from the communication interface
+ * 
+ * @param outByte Contains received byte after call
+ * 
+ * @return Whether a byte was available
+ */
+bool Comms::receiveByte(char* outByte)
+{
+	if (this->get_num_unread_bytes() == 0)
+		return false;
 
-	return i;
+	*outByte = this->read_byte();
+	return true;
 }
@@ -42,8 +42,20 @@ private:
 		return port->read();
 	}
 
+	/**
+	 * @brief Get the number of bytes that can be written to the port without blocking
+	 * 
+	 * @return Number of bytes
+	 */
+	size_t get_num_writable_bytes()
+	{
+		return (size_t)(port->availableForWrite());
+	}
+
 public:
 	void init(HardwareSerial* port, unsigned long baud);
+	void setBaud(unsigned long baud);
 	void sendInfo(const char *buffer, size_t size);
-	size_t receiveInfo(char* buffer, size_t length);
+	size_t getNumWritableBytes(void);
+	bool receiveByte(char* outByte);
 };
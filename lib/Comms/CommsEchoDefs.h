@@ -0,0 +1,29 @@
+#pragma once
+#include "Types.h"
+#include <MessageType.h>
+
+/*****************************************************
+ *                    ECHO FILTER                    *
+ *****************************************************/
+/**
+ * @brief Set by the host to choose which peripheral messages the controller board echoes back. 
+ * All types are echoed until a filter is received.
+ * 
+ */
+struct __attribute__((packed)) EchoFilter
+{
+	messageTypeMask suppressedTypes; // one bit per MessageType not echoed
+};
+
+/**
+ * @brief Check if a filter suppresses a MessageType
+ * 
+ * @param filter 
+ * @param type 
+ * @return Whether messages of this type are not echoed
+ */
+static inline bool isEchoSuppressed(const EchoFilter* filter, MessageType type)
+{
+	if ((uint8_t)type >= (uint8_t)MessageType::Count) return false;
+	return (filter->suppressedTypes & messageTypeBit(type)) != 0;
+}
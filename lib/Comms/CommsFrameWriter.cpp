@@ -0,0 +1,129 @@
+#include "CommsFrameWriter.h"
+#include "CommsFraming.h"
+
+/**
+ * @brief COBS-stuff one byte into the frame
+ * 
+ * @param byte 
+ */
+void FrameWriter::stuffByte(const uint8_t byte)
+{
+	if (byte == 0)
+	{
+		// Close block, code byte points to this zero
+		ring->writeUncommittedByte(this->codeIndex, (char)this->code);
+		this->codeIndex = this->frameSize++;
+		this->code = 1;
+		return;
+	}
+
+	ring->writeUncommittedByte(this->frameSize++, (char)byte);
+	this->code++;
+	if (this->code == 0xFF)
+	{
+		// Maximum block length reached
+		ring->writeUncommittedByte(this->codeIndex, (char)this->code);
+		this->codeIndex = this->frameSize++;
+		this->code = 1;
+	}
+}
+
+/**
+ * @brief Add one byte of the raw message to the CRC and the frame
+ * 
+ * @param byte 
+ */
+void FrameWriter::writeByte(const uint8_t byte)
+{
+	this->crc = framingCrc16(&byte, 1, this->crc);
+	this->stuffByte(byte);
+}
+
+/**
+ * @brief Begin a frame, writing the address char, type char and size char
+ * 
+ * @param type 
+ * @param contentSize Number of content bytes that will be written
+ * @param address Destination and source board
+ * @return Whether the frame was begun, false if the transmit buffer lacks space
+ */
+bool FrameWriter::begin(MessageType type, size_t contentSize, frameAddress address)
+{
+	if (
+		(contentSize > MESSAGE_CONTENT_LENGTH_MAX) ||
+		(ring->getNumFreeBytes() < FRAME_SIZE_FROM_RAW_SIZE(contentSize + MESSAGE_ENCODING_LENGTH))
+	)
+	{
+		this->numRefusedFrames++;
+		return false;
+	}
+
+	// First byte is reserved for the first code
+	this->isWriting = true;
+	this->frameSize = 1;
+	this->codeIndex = 0;
+	this->code = 1;
+	this->crc = FRAME_CRC_INIT;
+	this->numContentBytesRemaining = contentSize;
+
+	this->writeByte((uint8_t)address);
+	this->writeByte((uint8_t)type);
+	this->writeByte((uint8_t)contentSize);
+	return true;
+}
+
+/**
+ * @brief Write content bytes of the frame. Bytes beyond the declared content size are ignored.
+ * 
+ * @param content 
+ * @param size Number of bytes
+ */
+void FrameWriter::write(const char* content, size_t size)
+{
+	if (false == this->isWriting) return;
+
+	size = min(size, this->numContentBytesRemaining);
+	for (size_t i = 0; i < size; i++)
+		this->writeByte((uint8_t)content[i]);
+	this->numContentBytesRemaining -= size;
+}
+
+/**
+ * @brief Close the frame with its CRC and delimiter and make it ready to transmit. Content not 
+ * written up to the declared size is zero-filled.
+ * 
+ * @return Number of bytes in frame, including delimiter, or 0 if no frame was begun
+ */
+size_t FrameWriter::end(void)
+{
+	if (false == this->isWriting) return 0;
+
+	while (this->numContentBytesRemaining > 0)
+	{
+		this->writeByte(0);
+		this->numContentBytesRemaining--;
+	}
+
+	// Append CRC little-endian
+	uint16_t crcToWrite = this->crc;
+	this->stuffByte((uint8_t)(crcToWrite & 0xFF));
+	this->stuffByte((uint8_t)(crcToWrite >> 8));
+	ring->writeUncommittedByte(this->codeIndex, (char)this->code);
+
+	// Close frame
+	ring->writeUncommittedByte(this->frameSize++, FRAME_DELIMITER_CHAR);
+	ring->commitBytes(this->frameSize);
+
+	this->isWriting = false;
+	return this->frameSize;
+}
+
+/**
+ * @brief Get the number of frames not begun for lack of transmit buffer space
+ * 
+ * @return Number of frames
+ */
+unsigned long FrameWriter::getNumRefusedFrames(void)
+{
+	return this->numRefusedFrames;
+}
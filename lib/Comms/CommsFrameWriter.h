@@ -0,0 +1,53 @@
+#pragma once
+#include "Types.h"
+#include "Settings.h"
+#include <MessageType.h>
+#include <ByteRingBuffer.h>
+#include "CommsFraming.h"
+
+/**
+ * @brief A FrameWriter encodes a message straight into the transmit buffer as its bytes are 
+ * provided, so no raw message or frame is held anywhere else. The CRC is computed and the bytes 
+ * COBS-stuffed on the fly, producing exactly what framing a raw message would.
+ * 
+ * Space for the largest frame of the declared content size is checked on begin, so a begun frame 
+ * always completes.
+ */
+class FrameWriter
+{
+private:
+	ByteRingBuffer* ring;
+
+	/**
+	 * State of the frame being written
+	 */
+	bool isWriting;
+	size_t frameSize;
+	size_t codeIndex;
+	uint8_t code;
+	uint16_t crc;
+	size_t numContentBytesRemaining;
+
+	/**
+	 * Frames not begun for lack of transmit buffer space
+	 */
+	unsigned long numRefusedFrames;
+
+	void stuffByte(const uint8_t byte);
+	void writeByte(const uint8_t byte);
+public:
+	FrameWriter(ByteRingBuffer* ring) : 
+		ring(ring), 
+		isWriting(false), 
+		frameSize(0), 
+		codeIndex(0), 
+		code(1), 
+		crc(FRAME_CRC_INIT), 
+		numContentBytesRemaining(0),
+		numRefusedFrames(0) {};
+
+	bool begin(MessageType type, size_t contentSize, frameAddress address = FRAME_ADDRESS_UPSTREAM);
+	void write(const char* content, size_t size);
+	size_t end(void);
+	unsigned long getNumRefusedFrames(void);
+};
@@ -0,0 +1,225 @@
+#include "CommsFraming.h"
+
+/**
+ * @brief Compute the CRC-16/CCITT-FALSE of a buffer. Computed bitwise so no table is held in
+ * memory.
+ *
+ * @param data
+ * @param size Number of bytes
+ * @param crc Running CRC, to continue a previous computation
+ * @return uint16_t CRC
+ */
+uint16_t framingCrc16(const uint8_t* data, size_t size, uint16_t crc)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		crc ^= ((uint16_t)data[i]) << 8;
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ?
+				(uint16_t)((crc << 1) ^ FRAME_CRC_POLYNOMIAL) :
+				(uint16_t)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+/**
+ * @brief Read one byte of the stuffed frame contents without decoding the frame. COBS leaves 
+ * each non-zero byte in place, so only the code bytes ahead of it are walked.
+ *
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ * @param index Index of byte in frame contents, before stuffing
+ * @param outByte Contains byte after call
+ * @return Whether frame is long enough to hold the byte
+ */
+static bool framingPeekByte(const char* frame, size_t frameSize, size_t index, uint8_t* outByte)
+{
+	size_t codeIndex = 0;
+	while (codeIndex < frameSize)
+	{
+		uint8_t code = (uint8_t)frame[codeIndex];
+		if (code == 0) return false;
+
+		// Byte is within this block
+		if (index < (size_t)(code - 1))
+		{
+			if (codeIndex + 1 + index >= frameSize) return false;
+			*outByte = (uint8_t)frame[codeIndex + 1 + index];
+			return true;
+		}
+		index -= code - 1;
+		codeIndex += code;
+
+		// Each short block stands in for a zero, except the last
+		if ((code < 0xFF) && (codeIndex < frameSize))
+		{
+			if (index == 0)
+			{
+				*outByte = 0;
+				return true;
+			}
+			index--;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Unwrap a frame into its address char and raw message. The frame is COBS un-stuffed and 
+ * the CRC is verified.
+ *
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ * @param outRaw Contains address char then raw message after call, must be of minimum size 
+ * frameSize
+ * @param outRawSize Number of bytes in address char and raw message after call
+ * @return RET_FRAME_DECODE_EMPTY if frame contains nothing
+ * 		   RET_FRAME_DECODE_MALFORMED if COBS stuffing is invalid or frame is too short
+ * 		   RET_FRAME_DECODE_BAD_CRC if CRC does not match
+ *         RET_FRAME_DECODE_SUCCESS otherwise.
+ */
+int framingDecode(const char* frame, size_t frameSize, char* outRaw, size_t* outRawSize)
+{
+	if (frameSize == 0) return RET_FRAME_DECODE_EMPTY;
+
+	const uint8_t* in = (const uint8_t*)frame;
+	uint8_t* out = (uint8_t*)outRaw;
+	size_t inIndex = 0;
+	size_t outIndex = 0;
+
+	// Un-stuff every block
+	while (inIndex < frameSize)
+	{
+		uint8_t code = in[inIndex++];
+		if (code == 0) return RET_FRAME_DECODE_MALFORMED;
+
+		for (uint8_t i = 1; i < code; i++)
+		{
+			if ((inIndex >= frameSize) || (in[inIndex] == 0)) return RET_FRAME_DECODE_MALFORMED;
+			out[outIndex++] = in[inIndex++];
+		}
+
+		// Each short block stands in for a zero, except the last
+		if ((code < 0xFF) && (inIndex < frameSize))
+			out[outIndex++] = 0;
+	}
+
+	// Verify CRC
+	if (outIndex < FRAME_ADDRESS_LENGTH + MESSAGE_ENCODING_LENGTH + FRAME_CRC_LENGTH) 
+		return RET_FRAME_DECODE_MALFORMED;
+	size_t rawSize = outIndex - FRAME_CRC_LENGTH;
+	uint16_t received = (uint16_t)out[rawSize] | (((uint16_t)out[rawSize + 1]) << 8);
+	if (framingCrc16(out, rawSize) != received) return RET_FRAME_DECODE_BAD_CRC;
+
+	*outRawSize = rawSize;
+	return RET_FRAME_DECODE_SUCCESS;
+}
+
+/**
+ * Running check of a frame's raw bytes, see framingVerify
+ */
+struct FrameCheck
+{
+	size_t numRawBytes;
+	uint8_t sizeChar;
+	uint8_t trailing[FRAME_CRC_LENGTH];
+	uint16_t crc;
+};
+
+/**
+ * @brief Take one un-stuffed byte into a check. The last FRAME_CRC_LENGTH bytes are held back 
+ * from the CRC, as they may be the CRC itself.
+ *
+ * @param check
+ * @param byte
+ */
+static void framingCheckByte(FrameCheck* check, uint8_t byte)
+{
+	if (check->numRawBytes == FRAME_ADDRESS_LENGTH + 1)
+		check->sizeChar = byte;
+	if (check->numRawBytes >= FRAME_CRC_LENGTH)
+		check->crc = framingCrc16(&check->trailing[0], 1, check->crc);
+	check->trailing[0] = check->trailing[1];
+	check->trailing[1] = byte;
+	check->numRawBytes++;
+}
+
+/**
+ * @brief Check a frame as framingDecode would, without writing the raw message anywhere, so a 
+ * frame can be verified where it lies and still be relayed encoded.
+ *
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ * @return RET_FRAME_DECODE_EMPTY if frame contains nothing
+ * 		   RET_FRAME_DECODE_MALFORMED if COBS stuffing is invalid, or the message is not the size 
+ * 		   its size char declares
+ * 		   RET_FRAME_DECODE_BAD_CRC if CRC does not match
+ *         RET_FRAME_DECODE_SUCCESS otherwise.
+ */
+int framingVerify(const char* frame, size_t frameSize)
+{
+	if (frameSize == 0) return RET_FRAME_DECODE_EMPTY;
+
+	const uint8_t* in = (const uint8_t*)frame;
+	size_t inIndex = 0;
+	FrameCheck check = {0, 0, {0, 0}, FRAME_CRC_INIT};
+
+	// Un-stuff every block
+	while (inIndex < frameSize)
+	{
+		uint8_t code = in[inIndex++];
+		if (code == 0) return RET_FRAME_DECODE_MALFORMED;
+
+		for (uint8_t i = 1; i < code; i++)
+		{
+			if ((inIndex >= frameSize) || (in[inIndex] == 0)) return RET_FRAME_DECODE_MALFORMED;
+			framingCheckByte(&check, in[inIndex++]);
+		}
+
+		// Each short block stands in for a zero, except the last
+		if ((code < 0xFF) && (inIndex < frameSize))
+			framingCheckByte(&check, 0);
+	}
+
+	// Verify size and CRC
+	if (
+		check.numRawBytes != 
+		FRAME_ADDRESS_LENGTH + MESSAGE_ENCODING_LENGTH + (size_t)check.sizeChar + FRAME_CRC_LENGTH
+	)
+		return RET_FRAME_DECODE_MALFORMED;
+	uint16_t received = (uint16_t)check.trailing[0] | (((uint16_t)check.trailing[1]) << 8);
+	if (check.crc != received) return RET_FRAME_DECODE_BAD_CRC;
+
+	return RET_FRAME_DECODE_SUCCESS;
+}
+
+/**
+ * @brief Read the address char of a frame without decoding it. The CRC is not verified.
+ *
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ * @param outAddress Contains address after call
+ * @return Whether frame is long enough to hold an address
+ */
+bool framingPeekAddress(const char* frame, size_t frameSize, frameAddress* outAddress)
+{
+	return framingPeekByte(frame, frameSize, 0, outAddress);
+}
+
+/**
+ * @brief Read the MessageType of a frame without decoding it. The type char follows the address 
+ * char. The CRC is not verified.
+ *
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ * @return MessageType, or MessageType::Unused if frame is too short
+ */
+MessageType framingPeekType(const char* frame, size_t frameSize)
+{
+	uint8_t type;
+	if (false == framingPeekByte(frame, frameSize, FRAME_ADDRESS_LENGTH, &type)) 
+		return MessageType::Unused;
+	return (MessageType)type;
+}
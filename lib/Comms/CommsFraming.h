@@ -0,0 +1,36 @@
+#pragma once
+#include "Types.h"
+#include "Settings.h"
+#include <MessageType.h>
+
+/**
+ * Return codes
+ */
+#define RET_FRAME_DECODE_EMPTY (-3)
+#define RET_FRAME_DECODE_MALFORMED (-2)
+#define RET_FRAME_DECODE_BAD_CRC (-1)
+#define RET_FRAME_DECODE_SUCCESS (0)
+
+/**
+ * Frame sizing utilities. A frame is the COBS-stuffed message and CRC, plus the delimiter. Frames 
+ * are encoded by FrameWriter.
+ */
+#define FRAME_SIZE_FROM_RAW_SIZE(rawSize) ((rawSize) + FRAME_ENCODING_LENGTH)
+#define FRAME_SIZE_MAX (STRING_LENGTH_MAX - 1)
+
+/**
+ * The address char opening each frame, holding the destination board in its high nibble and the 
+ * source board in its low nibble. Board addresses are BOARD_ADDRESS_xxx.
+ */
+typedef uint8_t frameAddress;
+#define FRAME_ADDRESS(destination, source) ((frameAddress)(((destination) << 4) | ((source) & 0x0F)))
+#define FRAME_ADDRESS_DESTINATION(address) ((uint8_t)((address) >> 4))
+#define FRAME_ADDRESS_SOURCE(address) ((uint8_t)((address) & 0x0F))
+// Frames sent without a destination are for the host
+#define FRAME_ADDRESS_UPSTREAM FRAME_ADDRESS(BOARD_ADDRESS_HOST, BOARD_ADDRESS_SELF)
+
+uint16_t framingCrc16(const uint8_t* data, size_t size, uint16_t crc = FRAME_CRC_INIT);
+int framingDecode(const char* frame, size_t frameSize, char* outRaw, size_t* outRawSize);
+int framingVerify(const char* frame, size_t frameSize);
+bool framingPeekAddress(const char* frame, size_t frameSize, frameAddress* outAddress);
+MessageType framingPeekType(const char* frame, size_t frameSize);
@@ -1,4 +1,5 @@
 #include "CommsInterface.h"
+#include "CommsFraming.h"
 #include "MemoryUtilities.h"
 
 /**
@@ -12,58 +13,278 @@ void CommsInterface::init(HardwareSerial* port, unsigned long baud)
 }
 
 /**
- * @brief Receive available information and store in ring buffer.
+ * @brief Change the baud rate of Comms. Any frame partly received before the change is discarded, 
+ * so the first frame at the new rate is not appended to bytes received at the old one.
+ * 
+ * @param baud 
  */
-bool CommsInterface::receive(void)
+void CommsInterface::setBaud(unsigned long baud)
 {
-	// Construct a buffer to read into
-	char buffer[STRING_LENGTH_MAX];
+	this->flushTransmit();
+	comms->setBaud(baud);
+	ringBuffer->discardUnsealed();
+}
 
-	// Receive info into buffer
-	size_t numBytesRead = comms->receiveInfo(buffer, STRING_LENGTH_MAX);
+/**
+ * @brief Receive available bytes straight into the ring buffer. Stops once the ring buffer is 
+ * full, leaving the rest in the port until messages are released.
+ * 
+ * @return Number of bytes received
+ */
+size_t CommsInterface::receive(void)
+{
+	char byte;
+	size_t numBytesRead = 0;
 
-	// Write into buffer, sealing if the end char is encountered
-	ringBuffer->writeIntoBuffer(buffer, numBytesRead, true);
+	// Bound the bytes read per call, as the original single read was
+	while ((numBytesRead < STRING_LENGTH_MAX - 1) && !ringBuffer->isFull())
+	{
+		if (!comms->receiveByte(&byte))
+			break;
+		numBytesRead++;
+
+		// Write into buffer, sealing if the end char is encountered
+		if (ringBuffer->writeIntoBuffer(byte, true) == RET_WRITE_BUFFER_FULL)
+			break;
+	}
 
-	return numBytesRead > 0;
+	return numBytesRead;
 }
 
 /**
- * @brief Pop first unread message from ring buffer
+ * @brief Peek the first frame in the ring buffer, still encoded. Empty frames from consecutive 
+ * delimiters are released. The frame is valid until decodeFrame or releaseMessage.
  * 
- * @param outMessage Pointer to an uninitialized message object to initialize
+ * @param outFrame Points to frame, excluding delimiter, after call
+ * @return Number of bytes in frame, or 0 if none
  */
-int CommsInterface::popMessage(Message* outMessage)
+size_t CommsInterface::peekFrame(const char** outFrame)
 {
-	// Pop raw buffer contents
-	char buffer[STRING_LENGTH_MAX];
-	int ret = ringBuffer->popBuffer(buffer);
+	char* frame;
+	while ((frame = ringBuffer->peekBuffer()) != NULL)
+	{
+		// Frame contents end at the delimiter, as no other zero is present
+		size_t frameSize = stringLength(frame);
+		if (frameSize > 0)
+		{
+			*outFrame = frame;
+			return frameSize;
+		}
+
+		// Consecutive delimiters are not a damaged frame
+		ringBuffer->releaseBuffer();
+	}
+	return 0;
+}
+
+/**
+ * @brief Decode the first frame in the ring buffer in place. A frame which fails to decode is 
+ * counted as dropped. Either way the frame must be released once done with.
+ * 
+ * @param outView Points to message after call
+ * @param isCounted Whether to count the frame, false if verifyFrame already has
+ * @return Whether the frame held an intact message
+ */
+bool CommsInterface::decodeFrame(MessageView* outView, bool isCounted)
+{
+	char* frame = ringBuffer->peekBuffer();
+	if (frame == NULL) return false;
 
-	// Instantiate raw buffer content as a message
-	if (ret == RET_READ_BUFFER_SUCCESS)
+	// Un-stuffing never writes ahead of where it reads, so the frame is decoded over itself
+	size_t frameSize = stringLength(frame);
+	size_t rawSize;
+	int ret = framingDecode(frame, frameSize, frame, &rawSize);
+
+	// Frame must contain exactly the content its size char declares
+	char* raw = frame + FRAME_ADDRESS_LENGTH;
+	if (
+		(ret != RET_FRAME_DECODE_SUCCESS) ||
+		(rawSize != FRAME_ADDRESS_LENGTH + (size_t)((uint8_t)raw[1]) + MESSAGE_ENCODING_LENGTH)
+	)
 	{
-		outMessage->init(buffer);
-		return true;
+		if (isCounted && (ret != RET_FRAME_DECODE_EMPTY))
+			this->numDroppedFrames++;
+		return false;
+	}
+
+	// Terminate content over the first CRC byte, and view in place past the address char
+	frame[rawSize] = '\0';
+	outView->init(raw);
+	if (isCounted)
+		this->numReceivedFrames++;
+	return true;
+}
+
+/**
+ * @brief Verify the first frame in the ring buffer without decoding it, so it can be relayed 
+ * still encoded. The frame is counted as received or dropped, as by decodeFrame, and must be 
+ * released once done with.
+ * 
+ * @return Whether the frame holds an intact message
+ */
+bool CommsInterface::verifyFrame(void)
+{
+	char* frame = ringBuffer->peekBuffer();
+	if (frame == NULL) return false;
+
+	int ret = framingVerify(frame, stringLength(frame));
+	if (ret != RET_FRAME_DECODE_SUCCESS)
+	{
+		if (ret != RET_FRAME_DECODE_EMPTY)
+			this->numDroppedFrames++;
+		return false;
+	}
+	this->numReceivedFrames++;
+	return true;
+}
+
+/**
+ * @brief Peek first intact message in the ring buffer. Frames are decoded in place, so the view 
+ * points into the ring buffer and is valid until releaseMessage. Frames which fail to decode are 
+ * dropped, which resynchronizes the stream at the next frame delimiter.
+ * 
+ * @param outView Points to message after call
+ * @return Whether an intact message was found
+ */
+bool CommsInterface::peekMessage(MessageView* outView)
+{
+	const char* frame;
+	while (this->peekFrame(&frame) > 0)
+	{
+		if (this->decodeFrame(outView))
+			return true;
+		ringBuffer->releaseBuffer();
 	}
 	return false;
 }
 
 /**
- * @brief Send a message over the port
+ * @brief Release the message last peeked, freeing its place in the ring buffer. Any view of it 
+ * is invalid after call.
+ * 
+ */
+void CommsInterface::releaseMessage(void)
+{
+	ringBuffer->releaseBuffer();
+}
+
+/**
+ * @brief Check if any message is guaranteed to fit in the transmit buffer
+ * 
+ * @param numBytesReserved Bytes that must remain free after the message, for other senders
+ * @return Whether sendMessage will succeed
+ */
+bool CommsInterface::canSendMessage(size_t numBytesReserved)
+{
+	return txBuffer->getNumFreeBytes() >= (FRAME_SIZE_MAX + numBytesReserved);
+}
+
+/**
+ * @brief Get the number of bytes free in the transmit buffer
+ * 
+ * @return Number of bytes
+ */
+size_t CommsInterface::getNumFreeTransmitBytes(void)
+{
+	return txBuffer->getNumFreeBytes();
+}
+
+/**
+ * @brief Queue a message to send over the port, and send as much as the port accepts. Never blocks.
  * 
  * @param Message Pointer to an initialized message object
+ * @param address Destination and source board, the host by default
+ * @return Whether message was queued, false if transmit buffer is full
  */
-void CommsInterface::sendMessage(Message* message)
+bool CommsInterface::sendMessage(Message* message, frameAddress address)
 {
-	// Extract raw buffer contents
-	char buffer[STRING_LENGTH_MAX];
-	message->getRaw(buffer);
+	MessageView view;
+	message->asView(&view);
+	return this->sendMessage(&view, address);
+}
+
+/**
+ * @brief Queue a viewed message to send over the port, as for a Message. The frame is encoded 
+ * straight from wherever the view points, such as the receive ring buffer, into the transmit 
+ * buffer.
+ * 
+ * @param view Pointer to a view of a message
+ * @param address Destination and source board, the host by default
+ * @return Whether message was queued, false if transmit buffer is full
+ */
+bool CommsInterface::sendMessage(const MessageView* view, frameAddress address)
+{
+	if (false == frameWriter->begin(view->getType(), view->getContentSize(), address))
+		return false;
+	frameWriter->write(view->getContent(), view->getContentSize());
+	frameWriter->end();
 
-	// Compute message size
-	size_t size = message->getRawSize();
+	this->transmit();
+	return true;
+}
 
-	// Send
-	comms->sendInfo(buffer, size);
+/**
+ * @brief Queue a frame that is already encoded, such as one peeked from another interface, to 
+ * send over the port. The frame is copied as is, so it should first be checked with verifyFrame 
+ * on the interface it was received on.
+ * 
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ * @return Whether frame was queued, false if transmit buffer is full
+ */
+bool CommsInterface::relayFrame(const char* frame, size_t frameSize)
+{
+	const char delimiter = FRAME_DELIMITER_CHAR;
+	if (txBuffer->getNumFreeBytes() < frameSize + FRAME_DELIMITER_LENGTH)
+		return false;
+	txBuffer->writeIntoBuffer(frame, frameSize);
+	txBuffer->writeIntoBuffer(&delimiter, FRAME_DELIMITER_LENGTH);
+	this->numRelayedFrames++;
+
+	this->transmit();
+	return true;
+}
+
+/**
+ * @brief Get the writer encoding frames into the transmit buffer, for senders which serialize 
+ * directly rather than through a Message. Frames written are sent on the next transmit.
+ * 
+ * @return FrameWriter* 
+ */
+FrameWriter* CommsInterface::getFrameWriter(void)
+{
+	return this->frameWriter;
+}
+
+/**
+ * @brief Move queued bytes to the port until it would block. The port's transmit interrupt 
+ * drains them from there.
+ * 
+ */
+void CommsInterface::transmit(void)
+{
+	char chunk[STRING_LENGTH_MAX];
+	size_t numWritableBytes = comms->getNumWritableBytes();
+	while ((txBuffer->getNumOccupiedBytes() > 0) && (numWritableBytes > 0))
+	{
+		size_t size = txBuffer->readFromBuffer(chunk, min(numWritableBytes, (size_t)STRING_LENGTH_MAX));
+		comms->sendInfo(chunk, size);
+		numWritableBytes -= size;
+	}
+}
+
+/**
+ * @brief Send every queued byte, blocking until the port has accepted them all
+ * 
+ */
+void CommsInterface::flushTransmit(void)
+{
+	char chunk[STRING_LENGTH_MAX];
+	while (txBuffer->getNumOccupiedBytes() > 0)
+	{
+		size_t size = txBuffer->readFromBuffer(chunk, STRING_LENGTH_MAX);
+		comms->sendInfo(chunk, size);
+	}
 }
 
 /**
@@ -76,7 +297,47 @@ void CommsInterface::sendError(Error error)
 	Message message;
 	char buffer[STRING_LENGTH_MAX];
 	format(buffer, "Error [%d]: %s", error.code, error.message);
-	message.init(buffer);
+	message.init(MessageType::Error, MESSAGE_CONTENT_SIZE_AUTOMATIC, buffer);
 
 	this->sendMessage(&message);
 }
+
+/**
+ * @brief Get the number of frames received intact
+ * 
+ * @return Number of frames
+ */
+unsigned long CommsInterface::getNumReceivedFrames(void)
+{
+	return this->numReceivedFrames;
+}
+
+/**
+ * @brief Get the number of frames dropped for failing to decode
+ * 
+ * @return Number of frames
+ */
+unsigned long CommsInterface::getNumDroppedFrames(void)
+{
+	return this->numDroppedFrames;
+}
+
+/**
+ * @brief Get the number of frames not sent for lack of transmit buffer space
+ * 
+ * @return Number of frames
+ */
+unsigned long CommsInterface::getNumUnsentFrames(void)
+{
+	return frameWriter->getNumRefusedFrames();
+}
+
+/**
+ * @brief Get the number of frames relayed without being decoded
+ * 
+ * @return Number of frames
+ */
+unsigned long CommsInterface::getNumRelayedFrames(void)
+{
+	return this->numRelayedFrames;
+}
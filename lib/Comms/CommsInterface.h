@@ -1,10 +1,13 @@
 #pragma once
 #include "Types.h"
 #include <RingBuffer.h>
+#include <ByteRingBuffer.h>
 #include <Message.h>
+#include <MessageView.h>
 #include "Errors.h"
 #include "Settings.h"
 #include "Comms.h"
+#include "CommsFrameWriter.h"
 
 class CommsInterface
 {
@@ -18,26 +21,67 @@ private:
 	 * Each interface will manage all Comms streams via a Ring Buffer
 	 */
 	RingBuffer* ringBuffer;
+
+	/**
+	 * Encoded frames wait here until the port can accept them, so sending never blocks
+	 */
+	ByteRingBuffer* txBuffer;
+
+	/**
+	 * Every frame sent is encoded straight into txBuffer
+	 */
+	FrameWriter* frameWriter;
+
+	/**
+	 * Link quality statistics, counted as frames are decoded or verified
+	 */
+	unsigned long numReceivedFrames;
+	unsigned long numDroppedFrames;
+
+	/**
+	 * Frames copied in without being decoded
+	 */
+	unsigned long numRelayedFrames;
 public:
 	/**
 	 * @brief Constructor
 	 * 
 	 * @param port Must be a Hardware Serial not a Software Serial
 	 */
-	CommsInterface(void)
+	CommsInterface(void) : numReceivedFrames(0), numDroppedFrames(0), numRelayedFrames(0)
 	{
 		comms = new Comms();
 		ringBuffer = new RingBuffer();
+		txBuffer = new ByteRingBuffer();
+		frameWriter = new FrameWriter(txBuffer);
 	}
 
 	void init(HardwareSerial* port, unsigned long baud = EXTERNAL_COMMS_BAUD_RATE);
-	bool receive(void);
-	int popMessage(Message* outMessage);
-	void sendMessage(Message* message);
+	void setBaud(unsigned long baud);
+	size_t receive(void);
+	size_t peekFrame(const char** outFrame);
+	bool decodeFrame(MessageView* outView, bool isCounted = true);
+	bool verifyFrame(void);
+	bool peekMessage(MessageView* outView);
+	void releaseMessage(void);
+	bool canSendMessage(size_t numBytesReserved = 0);
+	size_t getNumFreeTransmitBytes(void);
+	bool sendMessage(Message* message, frameAddress address = FRAME_ADDRESS_UPSTREAM);
+	bool sendMessage(const MessageView* view, frameAddress address = FRAME_ADDRESS_UPSTREAM);
+	bool relayFrame(const char* frame, size_t frameSize);
+	FrameWriter* getFrameWriter(void);
 	void sendError(Error error);
+	void transmit(void);
+	void flushTransmit(void);
+	unsigned long getNumReceivedFrames(void);
+	unsigned long getNumDroppedFrames(void);
+	unsigned long getNumUnsentFrames(void);
+	unsigned long getNumRelayedFrames(void);
 
 	~CommsInterface()
 	{
+        delete frameWriter;
+        delete txBuffer;
         delete ringBuffer;
         delete comms;
     }
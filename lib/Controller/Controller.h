@@ -1,5 +1,6 @@
 #pragma once
 #include "MessageQueueHub.h"
+#include <CommsFrameWriter.h>
 
 /*****************************************************
  *                   ENUM UTILITIES                  *
@@ -7,6 +8,7 @@
 enum class ControllerMessageQueueOutput {
 	/* Enqueue */
 	EnqueueNoQueue,
+	EnqueuePoolEmpty,
 	EnqueueQueueFull,
 	EnqueueDisallowedType,
 	EnqueueSuccess,
@@ -30,6 +32,7 @@ static inline ControllerMessageQueueOutput toControllerMessageQueueOutputEnqueue
 	switch (messageQueueOutput)
 	{
 		case RET_ENQUEUE_NO_QUEUE: return ControllerMessageQueueOutput::EnqueueNoQueue;
+		case RET_ENQUEUE_POOL_IS_EMPTY: return ControllerMessageQueueOutput::EnqueuePoolEmpty;
 		case RET_ENQUEUE_QUEUE_IS_FULL: return ControllerMessageQueueOutput::EnqueueQueueFull;
 		case RET_ENQUEUE_DISALLOWED_TYPE: return ControllerMessageQueueOutput::EnqueueDisallowedType;
 		case RET_ENQUEUE_SUCCESS:
@@ -74,34 +77,56 @@ static inline ControllerMessageQueueOutput toControllerMessageQueueOutputClear(
 class ControllerGeneric
 {
 private:
-	bool requestPrioritizedSender;
+	/**
+	 * MessageType values received, fixed at compile time by the Controller declaration
+	 */
+	const messageTypeMask subscriptions;
 
 	virtual ControllerMessageQueueOutput purge(const MessageType desiredType) = 0;
 	virtual ControllerMessageQueueOutput read(const MessageType desiredType, Message* message) = 0;
 	virtual ControllerMessageQueueOutput post(Message* message) = 0;
 
-protected:
+public:
+	ControllerGeneric(messageTypeMask subscriptions) : subscriptions(subscriptions) {};
+
 	/**
-	 * @brief Request for controller messages to be prioritized
+	 * @brief Get the MessageType values this controller receives
 	 * 
 	 */
-	void setRequestPrioritizedSender(void) { this->requestPrioritizedSender = true; }
+	messageTypeMask getSubscriptions(void) const { return this->subscriptions; }
+
+	virtual ControllerMessageQueueOutput deliver(messageHandle handle, bool forceDelivery = false) = 0;
+	virtual ControllerMessageQueueOutput pickup(Message* message, MessagePriority priority) = 0;
 
 	/**
-	 * @brief Clear request for controller messages to be prioritized
+	 * @brief Get the number of pickups that passed over a waiting output type for another of its 
+	 * MessagePriority, a measure of its starvation
 	 * 
+	 * @param type Output MessageType
+	 * @return Number of pickups, saturating, or 0 if not an output type
 	 */
-	void clearRequestPrioritizedSender(void) { this->requestPrioritizedSender = false; }
-	
-public:
-	virtual ControllerMessageQueueOutput deliver(Message* message, bool forceDelivery = false) = 0;
-	virtual ControllerMessageQueueOutput pickup(Message* message) = 0;
+	virtual uint16_t getNumPassedOver(const MessageType type) = 0;
 
 	/**
-	 * @brief Return if is requesting its messages to be sent with priority
+	 * @brief Write frames straight into the transmit buffer, for controllers whose output is 
+	 * too heavy to pass through messagesOut. Streamed frames are Bulk traffic, so this is called 
+	 * once messagesOut is drained of every class.
 	 * 
+	 * @param writer Writer of the transmit buffer
+	 * @param numBytesBudget Bytes that may be written, which may be exceeded by the last frame
+	 * @return Number of bytes written
+	 */
+	virtual size_t stream(FrameWriter* writer, size_t numBytesBudget) { return 0; }
+
+	/**
+	 * @brief Check if a frame passing through this board for another should be held back, for
+	 * controllers which filter what is relayed
+	 *
+	 * @param type MessageType of the frame
+	 * @param destination Board the frame is addressed to
+	 * @return Whether the frame is not relayed
 	 */
-	bool isRequestingPrioritizedSender(void) { return this->requestPrioritizedSender; }
+	virtual bool isRelaySuppressed(MessageType type, uint8_t destination) { return false; }
 
     /**
      * @brief Core processing function
@@ -126,15 +151,97 @@ class Controller;
  * - All communications out of the Controller
  * - All processes within the Controller
  * 
- * @tparam messageTypesIn MessageType list
- * @tparam messageTypesOut MessageType list
+ * @tparam messageTypesIn MessageType queue policy list, see MessageQueue.h
+ * @tparam messageTypesOut MessageType queue policy list, see MessageQueue.h
  */
-template <MessageType... messageTypesIn, MessageType... messageTypesOut>
+template <typename... messageTypesIn, typename... messageTypesOut>
 class Controller<
 	MessageTypes<messageTypesIn...>, 
 	MessageTypes<messageTypesOut...>
 > : public ControllerGeneric
 {
+private:
+	static constexpr uint8_t numQueuesOut = sizeof...(messageTypesOut);
+
+	/**
+	 * Weighted pickup position of each priority class: the output queue slot taking its turn, 
+	 * and messages left in it
+	 */
+	uint8_t pickupSlot[(uint8_t)MessagePriority::Count];
+	uint8_t pickupCredit[(uint8_t)MessagePriority::Count];
+
+	/**
+	 * Pickups that passed over each waiting output queue slot
+	 */
+	uint16_t numPassedOver[(numQueuesOut > 0) ? numQueuesOut : 1];
+
+	/**
+	 * @brief Take the next message of a priority class by weighted round-robin over its output 
+	 * queues. Each class keeps its own turn, so pickups of the other classes between do not cut it 
+	 * short. A queue found empty forfeits the rest of its turn.
+	 * 
+	 * @return Slot taken from, or QUEUE_SLOT_NONE if all are empty
+	 */
+	uint8_t pickupWeighted(Message* message, MessagePriority priority)
+	{
+		uint8_t* slot = &this->pickupSlot[(uint8_t)priority];
+		uint8_t* credit = &this->pickupCredit[(uint8_t)priority];
+		for (uint8_t numTries = 0; numTries <= numQueuesOut; numTries++)
+		{
+			if (*credit == 0)
+			{
+				(*slot)++;
+				if (*slot >= numQueuesOut) *slot = 0;
+
+				// Queues of other classes take no turn here
+				if (messagesOut.getPriority(*slot) != priority)
+					continue;
+				*credit = messagesOut.getWeight(*slot);
+			}
+			if (messagesOut.dequeueSlot(*slot, message) == RET_DEQUEUE_SUCCESS)
+			{
+				(*credit)--;
+				return *slot;
+			}
+			*credit = 0;
+		}
+		return QUEUE_SLOT_NONE;
+	}
+
+	/**
+	 * @brief Take the next message of a priority class from the first non-empty output queue, in 
+	 * declaration order
+	 * 
+	 * @return Slot taken from, or QUEUE_SLOT_NONE if all are empty
+	 */
+	uint8_t pickupOrdered(Message* message, MessagePriority priority)
+	{
+		for (uint8_t slot = 0; slot < numQueuesOut; slot++)
+			if (
+				(messagesOut.getPriority(slot) == priority) &&
+				(messagesOut.dequeueSlot(slot, message) == RET_DEQUEUE_SUCCESS)
+			)
+				return slot;
+		return QUEUE_SLOT_NONE;
+	}
+
+	/**
+	 * @brief Count a pickup against every other output queue of its priority class left waiting. 
+	 * Queues of other classes wait on the class order, not on the weights, so are not counted.
+	 * 
+	 */
+	void notePassedOver(uint8_t takenSlot, MessagePriority priority)
+	{
+		for (uint8_t slot = 0; slot < numQueuesOut; slot++)
+			if (
+				(slot != takenSlot) && 
+				(messagesOut.getPriority(slot) == priority) && 
+				(false == messagesOut.isEmpty(slot)) && 
+				(this->numPassedOver[slot] < UINT16_MAX)
+			)
+				this->numPassedOver[slot]++;
+	}
+
 protected:
     MessageQueueHub<messageTypesIn...> messagesIn;
     MessageQueueHub<messageTypesOut...> messagesOut;
@@ -174,18 +281,25 @@ protected:
 		return toControllerMessageQueueOutputEnqueue(messagesOut.enqueue(message));
 	}	
 public:
-    Controller() = default;
+    Controller() : 
+		ControllerGeneric(messageTypesMask(messageTypesIn::type...))
+	{
+		memorySet(pickupSlot, (numQueuesOut > 0) ? numQueuesOut - 1 : 0, sizeof(pickupSlot));
+		memorySet(pickupCredit, 0, sizeof(pickupCredit));
+		memorySet(numPassedOver, 0, sizeof(numPassedOver));
+	};
     virtual ~Controller() = default;
 
 	/**
-	 * @brief Write a message to the messagesIn queue
+	 * @brief Write a message to the messagesIn queue. Only a reference to the pooled message is 
+	 * held, so delivery to many controllers costs the same as to one.
 	 * 
-	 * @param message To enqueue
+	 * @param handle Handle of pooled message to enqueue
      * @return ControllerMessageQueueOutput Enqueue value
 	 */
-    ControllerMessageQueueOutput deliver(Message* message, bool forceDelivery)
+    ControllerMessageQueueOutput deliver(messageHandle handle, bool forceDelivery)
     {
-		ControllerMessageQueueOutput enqueueOutput = toControllerMessageQueueOutputEnqueue(messagesIn.enqueue(message));
+		ControllerMessageQueueOutput enqueueOutput = toControllerMessageQueueOutputEnqueue(messagesIn.enqueue(handle));
 
 		// If queue is full and delivery is required, pop the oldest message
 		if (
@@ -195,36 +309,48 @@ public:
 		{
 			// Dequeud message disappears forever
 			Message dequeued;
-			ControllerMessageQueueOutput dequeueOutput = toControllerMessageQueueOutputDequeue(messagesIn.dequeue(message->getType(), &dequeued));
+			ControllerMessageQueueOutput dequeueOutput = toControllerMessageQueueOutputDequeue(messagesIn.dequeue(g_messagePool.get(handle)->getType(), &dequeued));
 			
 			// Retry enqueue
 			if (dequeueOutput == ControllerMessageQueueOutput::DequeueSuccess)
-				return toControllerMessageQueueOutputEnqueue(messagesIn.enqueue(message));
+				return toControllerMessageQueueOutputEnqueue(messagesIn.enqueue(handle));
 		}
 		return enqueueOutput;
 	}
 
 	/**
-	 * @brief Read a message from the messagesOut queue.
+	 * @brief Read a message of a priority class from the messagesOut queue. If any output type is 
+	 * Weighted, the queues are visited by weighted round-robin, otherwise in declaration order.
 	 * 
 	 * @param message Message to dequeue into
+	 * @param priority Class of MessageType to take from
      * @return ControllerMessageQueueOutput Dequeue value
-	 * If no messages left, to read, ControllerMessageQueueOutput::DequeueSuccess
+	 * If no messages of the class left to read, ControllerMessageQueueOutput::DequeueQueueEmpty
 	 */
-    ControllerMessageQueueOutput pickup(Message* message)
+    ControllerMessageQueueOutput pickup(Message* message, MessagePriority priority)
     {
+		uint8_t takenSlot = messagesOut.isWeighted() ? 
+			this->pickupWeighted(message, priority) : 
+			this->pickupOrdered(message, priority);
+		if (takenSlot == QUEUE_SLOT_NONE)
+			return ControllerMessageQueueOutput::DequeueQueueEmpty;
 
-		// Loop over all allowed output MessageTypes
-		constexpr MessageType types[] = { messageTypesOut... };
-        for (size_t i = 0; i < sizeof...(messageTypesOut); ++i)
-		{
-			ControllerMessageQueueOutput ret = toControllerMessageQueueOutputDequeue(
-				messagesOut.dequeue(types[i], message)
-			);
-			if (ret == ControllerMessageQueueOutput::DequeueSuccess)
-				return ret;
-		}
-		return ControllerMessageQueueOutput::DequeueQueueEmpty;
+		this->notePassedOver(takenSlot, priority);
+		return ControllerMessageQueueOutput::DequeueSuccess;
+	}
+
+	/**
+	 * @brief Get the number of pickups that passed over a waiting output type for another of its 
+	 * MessagePriority
+	 * 
+	 * @param type Output MessageType
+	 * @return Number of pickups, saturating, or 0 if not an output type
+	 */
+	uint16_t getNumPassedOver(const MessageType type)
+	{
+		uint8_t slot = messagesOut.locateSlotByType(type);
+		if (slot == QUEUE_SLOT_NONE) return 0;
+		return this->numPassedOver[slot];
 	}
 
     /**
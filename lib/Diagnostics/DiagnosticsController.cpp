@@ -0,0 +1,118 @@
+#include "MemoryUtilities.h"
+#include "DiagnosticsController.h"
+#include <Translate.h>
+
+/**
+ * @brief Construct a new DiagnosticsController
+ * 
+ */
+DiagnosticsController::DiagnosticsController(void) :
+	taskmaster(NULL),
+#if defined(BOARD_CONTROLLER)
+	loopTimes({0}),
+	lastReportTime(0),
+#endif
+	lastCountersReportTime(0) {}
+
+/**
+ * @brief Set the Taskmaster whose counters are reported. Called in setup, as the Taskmaster is 
+ * declared after its controllers.
+ * 
+ * @param taskmaster 
+ */
+void DiagnosticsController::init(Taskmaster* taskmaster)
+{
+	this->taskmaster = taskmaster;
+}
+
+/**
+ * @brief Count the duration of one main loop. Loop times are only reported by the controller 
+ * board.
+ * 
+ * @param loopTime 
+ */
+void DiagnosticsController::recordLoop(time_us loopTime)
+{
+#if defined(BOARD_CONTROLLER)
+	recordLoopTime(&(this->loopTimes), loopTime);
+#endif
+}
+
+/**
+ * @brief Send loop durations since last report, then start counting afresh
+ * 
+ */
+void DiagnosticsController::sendLoopTimeHistogram(void)
+{
+#if defined(BOARD_CONTROLLER)
+	Message message;
+	LoopTimeHistogramTranslation.asMessage(&(this->loopTimes), &message);
+	ControllerMessageQueueOutput result = this->post(&message);
+
+	if (result == ControllerMessageQueueOutput::EnqueueSuccess)
+	{
+		memorySet(&(this->loopTimes), 0, sizeof(LoopTimeHistogram));
+		this->lastReportTime = millis();
+	}
+#endif
+}
+
+/**
+ * @brief Send the counts of traffic passed over or lost since startup
+ * 
+ */
+void DiagnosticsController::sendDiagnosticsCounters(void)
+{
+	DiagnosticsCounters counters;
+	MessageType mostPassedOverType;
+	counters.numPassedOver = this->taskmaster->getMostPassedOver(&mostPassedOverType);
+	counters.mostPassedOverType = (uint8_t)mostPassedOverType;
+	counters.numRelayDropped = saturateCounter(this->taskmaster->getNumRelayDropped());
+	counters.numRelayOverflowed = saturateCounter(this->taskmaster->getNumRelayOverflowed());
+
+	Message message;
+	DiagnosticsCountersTranslation.asMessage(&counters, &message);
+	if (this->post(&message) == ControllerMessageQueueOutput::EnqueueSuccess)
+		this->lastCountersReportTime = millis();
+}
+
+/**
+ * @brief Determine if a report is due
+ * 
+ */
+bool DiagnosticsController::shouldReport(void)
+{
+#if defined(BOARD_CONTROLLER)
+	return (
+		DIAGNOSTICS_WILL_REPORT_LOOP_TIME &&
+		((millis() - this->lastReportTime) > DIAGNOSTICS_LOOP_TIME_REPORT_PERIOD)
+	);
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Determine if a counters report is due
+ * 
+ */
+bool DiagnosticsController::shouldReportCounters(void)
+{
+	return (
+		DIAGNOSTICS_WILL_REPORT_COUNTERS &&
+		(this->taskmaster != NULL) &&
+		((millis() - this->lastCountersReportTime) > DIAGNOSTICS_COUNTERS_REPORT_PERIOD)
+	);
+}
+
+/**
+ * @brief Report loop durations and counters periodically
+ * 
+ */
+void DiagnosticsController::process(void)
+{
+	if (this->shouldReport())
+		this->sendLoopTimeHistogram();
+	if (this->shouldReportCounters())
+		this->sendDiagnosticsCounters();
+}
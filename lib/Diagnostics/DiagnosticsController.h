@@ -0,0 +1,62 @@
+#pragma once
+#include "Types.h"
+#include <CommsInterface.h>
+#include <Controller.h>
+#include <Taskmaster.h>
+#include <DiagnosticsDefs.h>
+
+/*****************************************************
+ *                INPUT / OUTPUT TYPES               *
+ *****************************************************/
+using MessageTypesInDiagnostics = MessageTypes<>;
+#if defined(BOARD_CONTROLLER)
+using MessageTypesOutDiagnostics = MessageTypes<
+    Fifo<MessageType::LoopTimeHistogram>, // Loop durations over last period
+    Fifo<MessageType::DiagnosticsCounters> // Traffic passed over or lost since startup
+>;
+#else
+using MessageTypesOutDiagnostics = MessageTypes<
+    Fifo<MessageType::DiagnosticsCounters> // Traffic passed over or lost since startup
+>;
+#endif
+
+/*****************************************************
+ *                     CONTROLLER                    *
+ *****************************************************/
+class DiagnosticsController : public Controller<
+	MessageTypesInDiagnostics, 
+	MessageTypesOutDiagnostics
+>
+{
+private:
+	/**
+	 * Taskmaster whose controllers and ports are counted
+	 */
+	Taskmaster* taskmaster;
+
+#if defined(BOARD_CONTROLLER)
+	/**
+	 * Loop durations since last report
+	 */
+	LoopTimeHistogram loopTimes;
+	time_ms lastReportTime;
+#endif
+	time_ms lastCountersReportTime;
+
+	/**
+	 * @brief Communication utilities
+	 */
+	void sendLoopTimeHistogram(void);
+	void sendDiagnosticsCounters(void);
+
+	/**
+	 * @brief Process utilities
+	 */
+	bool shouldReport(void);
+	bool shouldReportCounters(void);
+public:
+	DiagnosticsController(void);
+	void init(Taskmaster* taskmaster);
+	void recordLoop(time_us loopTime);
+	void process(void);
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "Types.h"
+#include "Settings.h"
+
+/*****************************************************
+ *                 LOOP TIME HISTOGRAM               *
+ *****************************************************/
+/**
+ * Number of loops by duration. Bucket i counts loops shorter than 2^(FIRST_BUCKET_SHIFT + i) 
+ * micros, and the last bucket counts everything longer.
+ */
+struct __attribute__((packed)) LoopTimeHistogram
+{
+	uint16_t count[LOOP_TIME_HISTOGRAM_NUM_BUCKETS];
+	uint32_t maxLoopTime_us;
+};
+
+/**
+ * @brief Count one loop into the histogram
+ * 
+ * @param histogram Updated after call
+ * @param loopTime 
+ */
+static inline void recordLoopTime(LoopTimeHistogram* histogram, time_us loopTime)
+{
+	uint8_t bucket = 0;
+	time_us remaining = loopTime >> LOOP_TIME_HISTOGRAM_FIRST_BUCKET_SHIFT;
+	while ((remaining > 0) && (bucket < LOOP_TIME_HISTOGRAM_NUM_BUCKETS - 1))
+	{
+		remaining >>= 1;
+		bucket++;
+	}
+
+	// Saturate rather than wrap
+	if (histogram->count[bucket] < UINT16_MAX)
+		histogram->count[bucket]++;
+
+	if (loopTime > histogram->maxLoopTime_us)
+		histogram->maxLoopTime_us = loopTime;
+}
+
+/*****************************************************
+ *               DIAGNOSTICS COUNTERS                *
+ *****************************************************/
+/**
+ * Counts since startup of traffic a board passed over or lost. Each saturates rather than wraps.
+ */
+struct __attribute__((packed)) DiagnosticsCounters
+{
+	uint8_t mostPassedOverType; // output MessageType passed over most by pickup
+	uint16_t numPassedOver; // pickups that served another type while it waited
+	uint16_t numRelayDropped; // messages for other boards lost to an empty MessagePool
+	uint16_t numRelayOverflowed; // messages for other boards released from a full relay queue
+};
+
+/**
+ * @brief Narrow a counter for a DiagnosticsCounters field
+ * 
+ * @param count 
+ * @return count, or UINT16_MAX if larger
+ */
+static inline uint16_t saturateCounter(unsigned long count)
+{
+	return (count > UINT16_MAX) ? UINT16_MAX : (uint16_t)count;
+}
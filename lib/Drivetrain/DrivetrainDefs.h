@@ -2,71 +2,16 @@
 #include "MemoryUtilities.h"
 #include "Settings.h"
 #include "Types.h"
+#include <MessageSchema.h>
 
 /*****************************************************
  *                       ENUMS                       *
  *****************************************************/
 
 /**
- * Valid commands to be issued to the drivetrain under manual control.
+ * DrivetrainManualCommand, DrivetrainManualResponse, DrivetrainAutomatedResponse
+ * and DrivetrainEncoderState are generated from schema/messages.json into MessageSchema.h
  */
-enum class DrivetrainManualCommand
-{
-	Invalid,
-	NoReceived,
-	TranslateForward,
-	TranslateBackward,
-	RotateLeft,
-	RotateRight,
-    Brake,
-	Halt,
-	Automated,
-
-	Count
-};
-
-/**
- * Valid messages for drivetrain board to issue back under manual control.
- */
-enum class DrivetrainManualResponse
-{
-	Invalid,
-	NoReceived,
-	Acknowledge,
-	NotifyHalting,
-    NotifyBraking,
-	
-	Count
-};
-
-/**
- * Valid messages for drivetrain board to issue back under automated control
- */
-enum class DrivetrainAutomatedResponse
-{
-	Invalid,
-	NoReceived,
-	Acknowledge,
-	InProgress,
-	Overshot,
-	AtTarget,
-	Aborted,
-
-	Count
-};
-
-/**
- * Valid messages for drivetrain encoder communication
- * 
- */
-enum class DrivetrainEncoderState
-{
-	Invalid,
-	NoReceived,
-	Request,
-
-	Count
-};
 
 /*****************************************************
  *                      STRUCTS                      *
@@ -129,6 +74,47 @@ struct __attribute__((packed)) DrivetrainMotorCommand
 	motorSpeedRaw speed3;
 };
 
+/**
+ * Largest value of the compact drivetrain messages. Their scales, which the host divides out, are
+ * DRIVETRAIN_FIXED_POINT_x_SCALE in the generated MessageSchema.h.
+ */
+#define DRIVETRAIN_FIXED_POINT_MAX (INT16_MAX)
+
+/**
+ * Structure for raw encoder tick counts, scaled to inches by the receiver with ENCODER_x_TO_IN
+ */
+struct __attribute__((packed)) DrivetrainEncoderTicks
+{
+	int32_t encoder1Ticks;
+	int32_t encoder2Ticks;
+	int32_t encoder3Ticks;
+};
+
+/**
+ * Structure for drivetrain displacements in fixed point
+ * 
+ */
+struct __attribute__((packed)) DrivetrainDisplacementsFixed
+{
+	int16_t dX_centiIn; // directly forward
+	int16_t dY_centiIn; // 90 deg CCW
+	int16_t dTheta_centiRad; // CCW
+};
+
+/**
+ * Structure for motor commands on all three wheels in fixed point
+ */
+#define DRIVETRAIN_MOTOR_1_FORWARD_BIT (0x01)
+#define DRIVETRAIN_MOTOR_2_FORWARD_BIT (0x02)
+#define DRIVETRAIN_MOTOR_3_FORWARD_BIT (0x04)
+struct __attribute__((packed)) DrivetrainMotorCommandFixed
+{
+	uint8_t forwardBits; // DRIVETRAIN_MOTOR_x_FORWARD_BIT
+	motorSpeedApplied speed1;
+	motorSpeedApplied speed2;
+	motorSpeedApplied speed3;
+};
+
 
 /**
  * Compute drivetrain displacements from encoder information
@@ -203,6 +189,77 @@ static inline void drivetrainCommandFromDisplacements(
     command->dTheta_deg = (int16_t)(RAD_TO_DEG * displacements->dTheta_rad); // unit conversion
 }
 
+/**
+ * @brief Round a value to fixed point, saturating at the limits of an int16_t
+ * 
+ * @param value
+ * @param scale Fixed-point units per unit of value
+ * @return int16_t
+ */
+static inline int16_t fixedPointFromFloat(float32_t value, float32_t scale)
+{
+    float32_t scaled = value * scale;
+    if (scaled >= DRIVETRAIN_FIXED_POINT_MAX) return DRIVETRAIN_FIXED_POINT_MAX;
+    if (scaled <= -DRIVETRAIN_FIXED_POINT_MAX) return -DRIVETRAIN_FIXED_POINT_MAX;
+    return (int16_t)((scaled < 0) ? (scaled - 0.5f) : (scaled + 0.5f));
+}
+
+/**
+ * @brief Convert a set of drivetrain displacements into fixed point for sending
+ * 
+ * @param fixed Updated after call
+ * @param displacements
+ */
+static inline void displacementsFixedFromDisplacements(
+    DrivetrainDisplacementsFixed *fixed,
+    DrivetrainDisplacements *displacements
+)
+{
+    fixed->dX_centiIn = fixedPointFromFloat(
+        displacements->dX_in, DRIVETRAIN_FIXED_POINT_DISTANCE_SCALE);
+    fixed->dY_centiIn = fixedPointFromFloat(
+        displacements->dY_in, DRIVETRAIN_FIXED_POINT_DISTANCE_SCALE);
+    fixed->dTheta_centiRad = fixedPointFromFloat(
+        displacements->dTheta_rad, DRIVETRAIN_FIXED_POINT_ANGLE_SCALE);
+}
+
+/**
+ * @brief Convert a motor command into fixed point for sending. Speeds are rounded and limited to 
+ * what a motor can apply.
+ * 
+ * @param fixed Updated after call
+ * @param command
+ */
+static inline void motorCommandFixedFromMotorCommand(
+    DrivetrainMotorCommandFixed *fixed,
+    DrivetrainMotorCommand *command
+)
+{
+    fixed->forwardBits = \
+        (command->is1Forward ? DRIVETRAIN_MOTOR_1_FORWARD_BIT : 0) |
+        (command->is2Forward ? DRIVETRAIN_MOTOR_2_FORWARD_BIT : 0) |
+        (command->is3Forward ? DRIVETRAIN_MOTOR_3_FORWARD_BIT : 0);
+    fixed->speed1 = (motorSpeedApplied)constrain(command->speed1 + 0.5f, 0, UINT8_MAX);
+    fixed->speed2 = (motorSpeedApplied)constrain(command->speed2 + 0.5f, 0, UINT8_MAX);
+    fixed->speed3 = (motorSpeedApplied)constrain(command->speed3 + 0.5f, 0, UINT8_MAX);
+}
+
+/**
+ * @brief Scale raw encoder tick counts to distances
+ * 
+ * @param distances Updated after call
+ * @param ticks
+ */
+static inline void encoderDistancesFromTicks(
+    DrivetrainEncoderDistances *distances,
+    DrivetrainEncoderTicks *ticks
+)
+{
+    distances->encoder1Dist = (encoderDistance_in)ticks->encoder1Ticks * ENCODER_1_TO_IN;
+    distances->encoder2Dist = (encoderDistance_in)ticks->encoder2Ticks * ENCODER_2_TO_IN;
+    distances->encoder3Dist = (encoderDistance_in)ticks->encoder3Ticks * ENCODER_3_TO_IN;
+}
+
 /**
  * @brief Inverse kinematics. Get drivetrain displacement from encoder readings.
  * 
@@ -1,40 +1,12 @@
 #pragma once
 #include "Settings.h"
 #include "Types.h"
+#include <MessageSchema.h>
 
 /*****************************************************
  *                       ENUMS                       *
  *****************************************************/
 
 /**
- * Valid commands to be issued to the gripper.
+ * GripperCommand and GripperState are generated from schema/messages.json into MessageSchema.h
  */
-enum class GripperCommand
-{
-	Invalid,
-	NoReceived,
-    Home,
-	Extend,
-	Ready,
-	Open,
-	Close,
-    Ping,
-
-	Count
-};
-
-/**
- * Valid states from the gripper
- */
-enum class GripperState
-{
-	Invalid,
-	NoReceived,
-    Home,
-    ReadyClosed,
-    ReadyOpened,
-    ExtendedClosed,
-    ExtendedOpened,
-
-	Count
-};
\ No newline at end of file
@@ -75,8 +75,9 @@ LidarState Lidar::requestReading(LidarReading* reading)
 		return healthCheck;
 	}
 
-	// Clear bitmask
+	// Clear bitmask and qualities
 	memorySet(&(reading->bitmask), 0, sizeof(reading->bitmask));
+	memorySet(&(reading->quality), 0, sizeof(reading->quality));
 
 	// Start scan
 	if (IS_FAIL(this->rpLidar.startScan(true))) return LidarState::CannotScan;
@@ -116,6 +117,7 @@ LidarState Lidar::requestReading(LidarReading* reading)
 				BITMASK_SET(reading->bitmask, pointIdx);
 				reading->point[pointIdx].angle = (lidarAngle_deg)angle;
 				reading->point[pointIdx].distance = (lidarDistance_in)(MM_TO_INCH(distance));
+				NIBBLE_SET(reading->quality, pointIdx, LIDAR_QUALITY_TO_NIBBLE(quality));
 				reading->numCollected++;
 			}
 		}
@@ -1,6 +1,8 @@
 #pragma once
 #include "Types.h"
 #include "Settings.h"
+#include "MemoryUtilities.h"
+#include <MessageSchema.h>
 
 /*****************************************************
  *                 COMPILER UTILITIES                *
@@ -9,28 +11,46 @@
 #define BITMASK_SET(b, n)      ((b)[(n)/8] |=  (1 << ((n)%8)))
 #define BITMASK_CLEAR(b, n)    ((b)[(n)/8] &= ~(1 << ((n)%8)))
 
+/**
+ * A LidarScanChunk carries a start index and as many consecutive distances as fit in a message
+ */
+#define LIDAR_SCAN_CHUNK_HEADER_SIZE (sizeof(lidarPointIndex) + sizeof(uint8_t))
+#define LIDAR_SCAN_CHUNK_MAX_POINTS \
+	((MESSAGE_CONTENT_LENGTH_MAX - LIDAR_SCAN_CHUNK_HEADER_SIZE) / sizeof(lidarDistance_in))
+#define LIDAR_SCAN_CHUNK_SIZE(numPoints) \
+	(LIDAR_SCAN_CHUNK_HEADER_SIZE + ((numPoints) * sizeof(lidarDistance_in)))
+#define LIDAR_SCAN_CHUNK_NO_READING (0) // distance for points not collected in a sweep
+#define LIDAR_SCAN_CHUNK_DELTA_FLAG (0x8000) // set on startIndex when chunk updates the last scan
+
+/**
+ * A LidarScanChunkCompact carries the same header, then one zigzag varint distance delta per 
+ * point, then one 4-bit quality per point. Quality of 0 marks points not collected in a sweep.
+ */
+#define LIDAR_SCAN_CHUNK_COMPACT_ENCODED_SIZE (MESSAGE_CONTENT_LENGTH_MAX - LIDAR_SCAN_CHUNK_HEADER_SIZE)
+#define LIDAR_SCAN_CHUNK_COMPACT_MAX_POINTS (LIDAR_SCAN_CHUNK_COMPACT_ENCODED_SIZE) // >= 1 byte each
+#define LIDAR_VARINT_MAX_SIZE (3) // enough for a zigzag 16-bit delta
+#define LIDAR_QUALITY_NO_READING (0)
+#define LIDAR_QUALITY_TO_NIBBLE(q) ((((q) >> 2) > 0) ? ((q) >> 2) : 1) // 0 - 63 to 1 - 15
+#define NIBBLE_GET(b, n) ((((b)[(n)/2]) >> (4 * ((n)%2))) & 0x0F)
+#define NIBBLE_SET(b, n, v) \
+	((b)[(n)/2] = (uint8_t)(((b)[(n)/2] & (0xF0 >> (4 * ((n)%2)))) | (((v) & 0x0F) << (4 * ((n)%2)))))
+
+/**
+ * Select the message used to stream scans
+ */
+#if LIDAR_WILL_USE_COMPACT_SCAN_ENCODING
+#define LIDAR_SCAN_CHUNK_MESSAGE_TYPE MessageType::LidarScanChunkCompact
+#else
+#define LIDAR_SCAN_CHUNK_MESSAGE_TYPE MessageType::LidarScanChunk
+#endif
+
 /*****************************************************
  *                       ENUMS                       *
  *****************************************************/
 
 /**
- * Valid messages for Lidar communication
+ * LidarState is generated from schema/messages.json into MessageSchema.h
  */
-enum class LidarState
-{
-	Invalid,
-	NoReceived,
-	Request,
-	Rejected,
-	NotOpen,
-	CannotScan,
-	HealthUnknown,
-	NotHealthy,
-	Success,
-	Complete,
-
-	Count
-};
 
 /*****************************************************
  *                      STRUCTS                      *
@@ -45,14 +65,38 @@ struct __attribute__((packed)) LidarPointReading
 	lidarDistance_in distance;
 };
 
+/**
+ * Structure for a run of consecutive Lidar points. The angle of each point is implied by its 
+ * index, and only the first numPoints distances are transmitted.
+ */
+struct __attribute__((packed)) LidarScanChunk
+{
+	lidarPointIndex startIndex;
+	uint8_t numPoints;
+	lidarDistance_in distance[LIDAR_SCAN_CHUNK_MAX_POINTS];
+};
+
+/**
+ * Structure for a run of consecutive Lidar points, delta-encoded. Only the leading encoded bytes 
+ * in use are transmitted.
+ */
+struct __attribute__((packed)) LidarScanChunkCompact
+{
+	lidarPointIndex startIndex;
+	uint8_t numPoints;
+	uint8_t encoded[LIDAR_SCAN_CHUNK_COMPACT_ENCODED_SIZE];
+};
+
 /**
  * Structure for recording results of a complete Lidar sweep
  * Bitmask records which points have been with sufficient quality
+ * Quality records the 4-bit quality of each point, two to a byte
  */
 struct LidarReading
 {
 	LidarPointReading point[LIDAR_GRANULARITY_NUM_POINTS];
 	uint8_t bitmask[(LIDAR_GRANULARITY_NUM_POINTS + 7) / 8];
+	uint8_t quality[(LIDAR_GRANULARITY_NUM_POINTS + 1) / 2];
 	lidarPointIndex numCollected;
 	lidarPointIndex numProcessed;
 	lidarPointIndex indexToProcess;
@@ -99,4 +143,210 @@ static inline void markLidarReadingIndexProcessed(LidarReading* reading)
 static inline LidarPointReading* getCurrentLidarPointReading(LidarReading* reading)
 {
 	return &(reading->point[reading->indexToProcess]);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Populate a chunk with the consecutive points from the next valid point. The chunk ends 
+ * when full, or when enough uncollected points occur in a row that a new chunk is cheaper.
+ * 
+ * @param reading 
+ * @param chunk Updated after call
+ */
+static inline void fillLidarScanChunk(LidarReading* reading, LidarScanChunk* chunk)
+{
+	stepLidarReadingToNextValidPoint(reading);
+	chunk->startIndex = reading->indexToProcess;
+
+	lidarPointIndex pointIdx = reading->indexToProcess;
+	uint8_t numPoints = 0;
+	uint8_t numTrailingUncollected = 0;
+	while (
+		(pointIdx < LIDAR_GRANULARITY_NUM_POINTS) &&
+		(numPoints < LIDAR_SCAN_CHUNK_MAX_POINTS)
+	)
+	{
+		if (BITMASK_IS_SET(reading->bitmask, pointIdx))
+		{
+			numTrailingUncollected = 0;
+			chunk->distance[numPoints] = reading->point[pointIdx].distance;
+		}
+		else
+		{
+			if (numTrailingUncollected == LIDAR_SCAN_CHUNK_MAX_UNCOLLECTED) break;
+			numTrailingUncollected++;
+			chunk->distance[numPoints] = LIDAR_SCAN_CHUNK_NO_READING;
+		}
+		numPoints++;
+		pointIdx++;
+	}
+
+	// Never end on uncollected points
+	chunk->numPoints = numPoints - numTrailingUncollected;
+}
+
+/**
+ * @brief Write a value as an unsigned LEB128 varint
+ * 
+ * @param value 
+ * @param out Updated after call, must be of minimum size LIDAR_VARINT_MAX_SIZE
+ * @return uint8_t Number of bytes written
+ */
+static inline uint8_t encodeLidarVarint(uint16_t value, uint8_t* out)
+{
+	uint8_t size = 0;
+	while (value >= 0x80)
+	{
+		out[size++] = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	out[size++] = (uint8_t)value;
+	return size;
+}
+
+/**
+ * @brief Populate a compact chunk with the consecutive points from the next valid point. Each 
+ * distance is sent as the zigzag varint delta from the last collected distance, and ends under 
+ * the same conditions as fillLidarScanChunk.
+ * 
+ * @param reading 
+ * @param chunk Updated after call
+ * @return size_t Number of leading bytes of chunk in use
+ */
+static inline size_t fillLidarScanChunkCompact(LidarReading* reading, LidarScanChunkCompact* chunk)
+{
+	stepLidarReadingToNextValidPoint(reading);
+	chunk->startIndex = reading->indexToProcess;
+
+	uint8_t quality[(LIDAR_SCAN_CHUNK_COMPACT_MAX_POINTS + 1) / 2] = {0};
+	lidarPointIndex pointIdx = reading->indexToProcess;
+	lidarDistance_in lastDistance = 0;
+	uint8_t numPoints = 0;
+	uint8_t numTrailingUncollected = 0;
+	size_t numEncoded = 0;
+	size_t numEncodedAtLastCollected = 0;
+	while (
+		(pointIdx < LIDAR_GRANULARITY_NUM_POINTS) &&
+		(numPoints < LIDAR_SCAN_CHUNK_COMPACT_MAX_POINTS)
+	)
+	{
+		bool isCollected = BITMASK_IS_SET(reading->bitmask, pointIdx);
+		if ((!isCollected) && (numTrailingUncollected == LIDAR_SCAN_CHUNK_MAX_UNCOLLECTED)) break;
+
+		// Uncollected points repeat the last distance
+		int16_t delta = isCollected ? 
+			(int16_t)(reading->point[pointIdx].distance - lastDistance) : 0;
+		// Shifted unsigned, as a negative left shift is undefined
+		uint16_t zigzag = (uint16_t)(((uint16_t)delta << 1) ^ (uint16_t)(delta >> 15));
+		uint8_t varint[LIDAR_VARINT_MAX_SIZE];
+		uint8_t varintSize = encodeLidarVarint(zigzag, varint);
+
+		// Stop if this point and its quality would not fit
+		size_t numQualityBytes = ((size_t)numPoints + 2) / 2;
+		if (numEncoded + varintSize + numQualityBytes > LIDAR_SCAN_CHUNK_COMPACT_ENCODED_SIZE) break;
+
+		memoryCopy(&(chunk->encoded[numEncoded]), varint, varintSize);
+		numEncoded += varintSize;
+		NIBBLE_SET(
+			quality, 
+			numPoints, 
+			isCollected ? NIBBLE_GET(reading->quality, pointIdx) : LIDAR_QUALITY_NO_READING
+		);
+		numPoints++;
+		pointIdx++;
+
+		if (isCollected)
+		{
+			lastDistance = reading->point[pointIdx - 1].distance;
+			numTrailingUncollected = 0;
+			numEncodedAtLastCollected = numEncoded;
+		}
+		else
+		{
+			numTrailingUncollected++;
+		}
+	}
+
+	// Never end on uncollected points, then append qualities
+	chunk->numPoints = numPoints - numTrailingUncollected;
+	size_t numQualityBytes = ((size_t)chunk->numPoints + 1) / 2;
+	memoryCopy(&(chunk->encoded[numEncodedAtLastCollected]), quality, numQualityBytes);
+	return LIDAR_SCAN_CHUNK_HEADER_SIZE + numEncodedAtLastCollected + numQualityBytes;
+}
+
+/**
+ * @brief Mark all points in a run as processed
+ * 
+ * @param reading 
+ * @param startIndex First point of run
+ * @param numPoints Number of points in run
+ */
+static inline void markLidarReadingRangeProcessed(
+	LidarReading* reading, 
+	lidarPointIndex startIndex, 
+	uint8_t numPoints
+)
+{
+	for (uint8_t i = 0; i < numPoints; i++)
+	{
+		lidarPointIndex pointIdx = startIndex + i;
+		if (BITMASK_IS_SET(reading->bitmask, pointIdx))
+		{
+			BITMASK_CLEAR(reading->bitmask, pointIdx);
+			reading->numProcessed++;
+		}
+	}
+	reading->indexToProcess = startIndex + numPoints;
+}
+
+/**
+ * @brief Reduce a reading to only the points which changed from the last scan sent by more than 
+ * a threshold, and record those points as sent. Points which are no longer collected are not 
+ * reported, so the last distance stands until the next keyframe.
+ * 
+ * @param reading Updated after call
+ * @param lastSent Distance of every point as last sent, updated after call
+ * @param threshold Changes up to this distance are not sent
+ */
+static inline void reduceLidarReadingToChanges(
+	LidarReading* reading, 
+	lidarDistance_in* lastSent, 
+	lidarDistance_in threshold
+)
+{
+	for (lidarPointIndex pointIdx = 0; pointIdx < LIDAR_GRANULARITY_NUM_POINTS; pointIdx++)
+	{
+		if (false == BITMASK_IS_SET(reading->bitmask, pointIdx)) continue;
+
+		lidarDistance_in distance = reading->point[pointIdx].distance;
+		lidarDistance_in change = distance - lastSent[pointIdx];
+		if (
+			(lastSent[pointIdx] == LIDAR_SCAN_CHUNK_NO_READING) ||
+			(change > threshold) ||
+			(change < -threshold)
+		)
+		{
+			lastSent[pointIdx] = distance;
+			continue;
+		}
+
+		// Unchanged
+		BITMASK_CLEAR(reading->bitmask, pointIdx);
+		reading->numCollected--;
+	}
+}
+
+/**
+ * @brief Record every point of a reading as sent, to serve as a keyframe for later changes
+ * 
+ * @param reading 
+ * @param lastSent Distance of every point as last sent, updated after call
+ */
+static inline void recordLidarReadingKeyframe(LidarReading* reading, lidarDistance_in* lastSent)
+{
+	for (lidarPointIndex pointIdx = 0; pointIdx < LIDAR_GRANULARITY_NUM_POINTS; pointIdx++)
+	{
+		lastSent[pointIdx] = BITMASK_IS_SET(reading->bitmask, pointIdx) ?
+			reading->point[pointIdx].distance :
+			LIDAR_SCAN_CHUNK_NO_READING;
+	}
+}
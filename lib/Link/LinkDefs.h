@@ -0,0 +1,110 @@
+#pragma once
+#include "Types.h"
+#include "Settings.h"
+
+/*****************************************************
+ *                     BAUD RATES                    *
+ *****************************************************/
+#define LINK_BAUD_RATE_INDEX_BASE (0) // both boards start here, INTERNAL_COMMS_BAUD_RATE
+#define LINK_NUM_BAUD_RATES (5)
+
+/**
+ * @brief Get the baud rate for an index. Rates are chosen for low error on a 16 MHz clock.
+ * 
+ * @param rateIndex 
+ * @return Baud rate, INTERNAL_COMMS_BAUD_RATE for unknown indices
+ */
+static inline unsigned long linkBaudRate(uint8_t rateIndex)
+{
+	switch (rateIndex)
+	{
+		case 1: return 38400;
+		case 2: return 57600;
+		case 3: return 115200;
+		case 4: return 250000;
+		case LINK_BAUD_RATE_INDEX_BASE:
+		default: return INTERNAL_COMMS_BAUD_RATE;
+	}
+}
+
+static_assert(LINK_BAUD_RATE_INDEX_MAX < LINK_NUM_BAUD_RATES, "Unknown maximum baud rate index");
+
+/*****************************************************
+ *                    LINK CONTROL                   *
+ *****************************************************/
+/**
+ * @brief Operations exchanged between the controller, which leads negotiation, and the peripheral
+ * 
+ */
+enum class LinkOperation : uint8_t {
+	Offer, // controller -> peripheral, fastest rate index controller will use
+	Accept, // peripheral -> controller, fastest rate index both will use
+	Switch, // controller -> peripheral, both change to rate index and begin testing
+	Test, // controller -> peripheral, carries test pattern
+	TestEcho, // peripheral -> controller, returns test pattern
+	Heartbeat, // controller -> peripheral, commits a tested rate index and keeps it alive
+	HeartbeatEcho, // peripheral -> controller, answers each heartbeat at the committed rate
+};
+
+struct __attribute__((packed)) LinkControl
+{
+	uint8_t operation; // LinkOperation
+	uint8_t rateIndex;
+	uint8_t pattern[LINK_TEST_PATTERN_LENGTH];
+};
+
+/**
+ * @brief Fill the test pattern. Alternating bits, zeros and runs exercise the UART and framing.
+ * 
+ * @param pattern Of size LINK_TEST_PATTERN_LENGTH
+ */
+static inline void fillLinkTestPattern(uint8_t* pattern)
+{
+	static const uint8_t bytes[] = { 0x55, 0xAA, 0x00, 0xFF, 0x0F, 0xF0, 0x33, 0xCC };
+	for (uint8_t i = 0; i < LINK_TEST_PATTERN_LENGTH; i++)
+		pattern[i] = bytes[i % sizeof(bytes)];
+}
+
+/**
+ * @brief Determine if a received test pattern is intact
+ * 
+ * @param pattern Of size LINK_TEST_PATTERN_LENGTH
+ */
+static inline bool isLinkTestPatternIntact(const uint8_t* pattern)
+{
+	uint8_t expected[LINK_TEST_PATTERN_LENGTH];
+	fillLinkTestPattern(expected);
+	for (uint8_t i = 0; i < LINK_TEST_PATTERN_LENGTH; i++)
+		if (pattern[i] != expected[i]) return false;
+	return true;
+}
+
+/**
+ * @brief Build a LinkControl
+ * 
+ * @param control Filled after call
+ * @param operation 
+ * @param rateIndex 
+ */
+static inline void fillLinkControl(LinkControl* control, LinkOperation operation, uint8_t rateIndex)
+{
+	control->operation = (uint8_t)operation;
+	control->rateIndex = rateIndex;
+	fillLinkTestPattern(control->pattern);
+}
+
+/*****************************************************
+ *                    LINK MONITOR                   *
+ *****************************************************/
+/**
+ * @brief Determine if the link has degraded, from frame counts over one monitoring period
+ * 
+ * @param numReceived Frames received intact during period
+ * @param numDropped Frames dropped during period
+ */
+static inline bool isLinkDegraded(unsigned long numReceived, unsigned long numDropped)
+{
+	unsigned long numFrames = numReceived + numDropped;
+	if (numFrames < LINK_MONITOR_MIN_FRAMES) return false;
+	return (numDropped * 100) > (numFrames * LINK_MONITOR_MAX_DROPPED_PERCENT);
+}
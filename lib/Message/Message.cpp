@@ -12,24 +12,11 @@ void Message::init(const char* rawBuffer)
 	// Decode information
 	if (rawBuffer != NULL)
 	{
-		// Cast the first char to a MessageType
-		this->type = static_cast<MessageType>(rawBuffer[0]);
-
-		// Cast the second char to a size_t
-		this->msgContentSize = (size_t)(rawBuffer[1]);
-
-		// Encode raw information
-		size_t rawLength = this->msgContentSize + MESSAGE_ENCODING_LENGTH;
-		memoryCopy(this->msgRawBuffer, rawBuffer, rawLength);
-		this->msgRawBuffer[rawLength] = '\0';
-
-		// Encode raw infromation without MessageType char, size char, or end char
-		size_t contentLength = rawLength - MESSAGE_ENCODING_LENGTH;
-		memoryCopy(this->msgContentBuffer, &(rawBuffer[MESSAGE_PRE_ENCODE_LENGTH]), contentLength);
-		this->msgContentBuffer[contentLength] = '\0';
-
-		// Properly initialized
-		this->initialized = true;
+		this->init(
+			static_cast<MessageType>(rawBuffer[0]), 
+			(size_t)((uint8_t)rawBuffer[1]), 
+			&(rawBuffer[MESSAGE_PRE_ENCODE_LENGTH])
+		);
 	}
 }
 
@@ -46,36 +33,31 @@ void Message::init(MessageType type, const size_t contentSize, const char* conte
 	// Encode information
 	if (contentBuffer != NULL)
 	{
-		// Store MessageType
-		this->type = type;
-
-		// Store content size
-		// Must be less than MESSAGE_CONTENT_LENGTH_MAX to be properly transmitted
-		this->msgContentSize = (contentSize == MESSAGE_CONTENT_SIZE_AUTOMATIC) ?
+		// Content size must be less than MESSAGE_CONTENT_LENGTH_MAX to be properly transmitted
+		size_t size = (contentSize == MESSAGE_CONTENT_SIZE_AUTOMATIC) ?
 			stringLength(contentBuffer, MESSAGE_CONTENT_LENGTH_MAX) :
-			contentSize;
-
-		// Store unencoded content
-		memoryCopy(this->msgContentBuffer, contentBuffer, this->msgContentSize);
-		this->msgContentBuffer[this->msgContentSize] = '\0';
+			min(contentSize, (size_t)MESSAGE_CONTENT_LENGTH_MAX);
 
-		// Encode raw information with MessageType char and end char
-		this->msgRawBuffer[0] = static_cast<char>(this->type);
-		this->msgRawBuffer[1] = static_cast<char>(this->msgContentSize);
-		memoryCopy(
-			&(this->msgRawBuffer[MESSAGE_PRE_ENCODE_LENGTH]), 
-			this->msgContentBuffer, 
-			this->msgContentSize
-		);
-		this->msgRawBuffer[this->msgContentSize + MESSAGE_PRE_ENCODE_LENGTH] = MESSAGE_END_CHAR;
-		this->msgRawBuffer[this->msgContentSize + MESSAGE_ENCODING_LENGTH] = '\0';
-		
-		// Properly initialized
-		this->initialized = true;
+		// Encode raw information with MessageType char and size char
+		this->msgRawBuffer[0] = static_cast<char>(type);
+		this->msgRawBuffer[1] = static_cast<char>(size);
+		memoryCopy(&(this->msgRawBuffer[MESSAGE_PRE_ENCODE_LENGTH]), contentBuffer, size);
+		this->msgRawBuffer[size + MESSAGE_ENCODING_LENGTH] = '\0';
 	}
 	
 }
 
+/**
+ * @brief Initialize Message from a view of a message held elsewhere. Only the content is copied.
+ * 
+ * @param view 
+ */
+void Message::init(const MessageView* view)
+{
+	if (view != NULL)
+		this->init(view->getType(), view->getContentSize(), view->getContent());
+}
+
 /**
  * @brief Get message content size
  * 
@@ -83,7 +65,7 @@ void Message::init(MessageType type, const size_t contentSize, const char* conte
  */
 size_t Message::getContentSize(void)
 {
-	return this->msgContentSize;
+	return (size_t)((uint8_t)this->msgRawBuffer[1]);
 }
 
 /**
@@ -93,7 +75,7 @@ size_t Message::getContentSize(void)
  */
 MessageType Message::getType(void)
 {
-	return this->type;
+	return static_cast<MessageType>(this->msgRawBuffer[0]);
 }
 
 /**
@@ -106,8 +88,9 @@ void Message::getContent(char* outBuffer)
 {
 	if (outBuffer != NULL)
 	{
-		memoryCopy(outBuffer, this->msgContentBuffer, this->msgContentSize);
-		outBuffer[this->msgContentSize] = '\0';
+		size_t contentSize = this->getContentSize();
+		memoryCopy(outBuffer, &(this->msgRawBuffer[MESSAGE_PRE_ENCODE_LENGTH]), contentSize);
+		outBuffer[contentSize] = '\0';
 	}
 }
 
@@ -121,7 +104,7 @@ void Message::getRaw(char* outBuffer)
 {
 	if (outBuffer != NULL)
 	{
-		size_t rawLength = this->msgContentSize + MESSAGE_ENCODING_LENGTH;
+		size_t rawLength = this->getRawSize();
 		memoryCopy(outBuffer, this->msgRawBuffer, rawLength);
 		outBuffer[rawLength] = '\0';
 	}
@@ -134,5 +117,16 @@ void Message::getRaw(char* outBuffer)
  */
 size_t Message::getRawSize(void)
 {
-	return this->msgContentSize + MESSAGE_ENCODING_LENGTH;
+	return this->getContentSize() + MESSAGE_ENCODING_LENGTH;
+}
+
+/**
+ * @brief Get a view of this message, without copying. Valid while the message is unchanged.
+ * 
+ * @param outView Points into this message after call
+ */
+void Message::asView(MessageView* outView)
+{
+	if (outView != NULL)
+		outView->init(this->msgRawBuffer);
 }
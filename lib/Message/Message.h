@@ -2,6 +2,7 @@
 #include "Settings.h"
 #include "MemoryUtilities.h"
 #include "MessageType.h"
+#include "MessageView.h"
 
 #define MESSAGE_CONTENT_SIZE_AUTOMATIC (0xFF) // message content is null-terminated stirng
 
@@ -14,27 +15,14 @@ class Message
 {
 private:
 	/**
-	 * Whether message has been populated yet
-	 * 
+	 * The only representation of the message: the type char, size char, content, and 
+	 * null-terminator. Type, size and content are all read in place from it, so every queue slot 
+	 * holds each byte once. Framing for the wire is applied by the CommsInterface.
 	 */
-	bool initialized;
-
-	/**
-	 * The underlying representation of the message with the Message type and content separated
-	 */
-	MessageType type;
-	char msgContentBuffer[MESSAGE_CONTENT_LENGTH_MAX];
-	size_t msgContentSize;
-
-	/**
-	 * The serialized representation of the message including the type char, content, end char, and 
-	 * null-terminator
-	 */
-	char msgRawBuffer[STRING_LENGTH_MAX];
+	char msgRawBuffer[MESSAGE_RAW_LENGTH_MAX + 1];
 
 public:
-	Message(void) : initialized(false), msgContentSize(MESSAGE_CONTENT_SIZE_AUTOMATIC) {
-		memorySet(this->msgContentBuffer, '\0', sizeof(msgContentBuffer));
+	Message(void) {
 		memorySet(this->msgRawBuffer, '\0', sizeof(msgRawBuffer));
 	};
 
@@ -42,6 +30,7 @@ public:
 	 * A message can either be initialized from:
 	 * (1) a pure string representation, as when receiving from Serial
 	 * (2) a type/size/content representation, as when sending on Serial
+	 * (3) a view of a message held elsewhere, as when queueing a received message
 	 * 
 	 * A size needs not be specified unless content contains \0s in addition to null-terminator.
 	 * This may be the case if the values being sent are serialized structs rather than enums.
@@ -55,10 +44,14 @@ public:
 		const size_t contentSize,
 		const char* contentBuffer
 	);
+	void init(
+		const MessageView* view
+	);
 
 	MessageType getType(void);
 	size_t getContentSize(void);
 	void getContent(char* outBuffer);
 	void getRaw(char* outBuffer);
 	size_t getRawSize(void);
+	void asView(MessageView* outView);
 };
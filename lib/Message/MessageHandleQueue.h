@@ -0,0 +1,74 @@
+#pragma once
+#include "MessagePool.h"
+
+/**
+ * @brief A MessageHandleQueue is a bounded first-in first-out ring of MessagePool handles, for
+ * holding messages outside a Controller. Each handle held counts as a reference to its slot, and 
+ * is kept with one tag byte for the holder's use, such as the frame address to send it with.
+ * When full, the oldest message is released to make room for the newest, and counted.
+ * 
+ * @tparam queueDepth Messages held
+ */
+template <uint8_t queueDepth>
+class MessageHandleQueue
+{
+private:
+	static_assert(queueDepth > 0, "MessageHandleQueue depth must be at least 1");
+
+	messageHandle handles[queueDepth];
+	uint8_t tags[queueDepth];
+	uint8_t head; // oldest message
+	uint8_t count;
+
+	/**
+	 * Messages released to make room for newer ones
+	 */
+	unsigned long numOverflowed;
+
+public:
+	MessageHandleQueue(void) : head(0), count(0), numOverflowed(0) {}
+
+	bool isEmpty(void) const { return this->count == 0; }
+
+	/**
+	 * @brief Hold a handle whose reference is already counted, releasing the oldest if full
+	 * 
+	 * @param handle
+	 * @param tag Kept with the handle
+	 */
+	void push(messageHandle handle, uint8_t tag = 0)
+	{
+		if (this->count == queueDepth)
+		{
+			g_messagePool.release(this->pop());
+			this->numOverflowed++;
+		}
+		uint8_t tail = (this->head + this->count) % queueDepth;
+		this->handles[tail] = handle;
+		this->tags[tail] = tag;
+		this->count++;
+	}
+
+	/**
+	 * @brief Take the oldest handle, whose reference passes to the caller
+	 * 
+	 * @param outTag Contains the tag kept with the handle after call, if given
+	 * @return Handle, or MESSAGE_HANDLE_NONE if empty
+	 */
+	messageHandle pop(uint8_t* outTag = NULL)
+	{
+		if (this->count == 0) return MESSAGE_HANDLE_NONE;
+		messageHandle handle = this->handles[this->head];
+		if (outTag != NULL) *outTag = this->tags[this->head];
+		this->head = (this->head + 1) % queueDepth;
+		this->count--;
+		return handle;
+	}
+
+	/**
+	 * @brief Get the number of messages released to make room for newer ones
+	 * 
+	 * @return Number of messages
+	 */
+	unsigned long getNumOverflowed(void) const { return this->numOverflowed; }
+};
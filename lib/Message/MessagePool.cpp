@@ -0,0 +1,96 @@
+#include "MessagePool.h"
+
+MessagePool g_messagePool;
+
+static_assert(MESSAGE_POOL_SIZE < MESSAGE_HANDLE_NONE, "MESSAGE_POOL_SIZE exceeds handle range");
+
+/**
+ * @brief Take a free slot, holding one reference to it, and stamp it with the current time. The 
+ * message in it must be initialized by the caller.
+ * 
+ * @return Handle of slot, or MESSAGE_HANDLE_NONE if none are free
+ */
+messageHandle MessagePool::allocate(void)
+{
+	for (messageHandle handle = 0; handle < MESSAGE_POOL_SIZE; handle++)
+	{
+		if (numReferences[handle] == 0)
+		{
+			numReferences[handle] = 1;
+			stamps[handle] = millis();
+			return handle;
+		}
+	}
+	this->numFailedAllocations++;
+	return MESSAGE_HANDLE_NONE;
+}
+
+/**
+ * @brief Get the message in a slot
+ * 
+ * @param handle 
+ * @return Message* or NULL if handle is invalid
+ */
+Message* MessagePool::get(messageHandle handle)
+{
+	if (handle >= MESSAGE_POOL_SIZE) return NULL;
+	return &(slots[handle]);
+}
+
+/**
+ * @brief Get the time since a slot was allocated, i.e. since its message was received or posted
+ * 
+ * @param handle 
+ * @return Age in millis, or 0 if handle is invalid
+ */
+time_ms MessagePool::getAge(messageHandle handle)
+{
+	if (handle >= MESSAGE_POOL_SIZE) return 0;
+	return millis() - stamps[handle];
+}
+
+/**
+ * @brief Add a reference to a slot, for a new holder of its message
+ * 
+ * @param handle 
+ */
+void MessagePool::retain(messageHandle handle)
+{
+	if (handle < MESSAGE_POOL_SIZE)
+		numReferences[handle]++;
+}
+
+/**
+ * @brief Remove a reference to a slot, freeing it once none remain
+ * 
+ * @param handle 
+ */
+void MessagePool::release(messageHandle handle)
+{
+	if ((handle < MESSAGE_POOL_SIZE) && (numReferences[handle] > 0))
+		numReferences[handle]--;
+}
+
+/**
+ * @brief Get the number of slots free to allocate
+ * 
+ * @return Number of slots
+ */
+uint8_t MessagePool::getNumFreeSlots(void)
+{
+	uint8_t numFreeSlots = 0;
+	for (messageHandle handle = 0; handle < MESSAGE_POOL_SIZE; handle++)
+		if (numReferences[handle] == 0)
+			numFreeSlots++;
+	return numFreeSlots;
+}
+
+/**
+ * @brief Get the number of allocations refused for lack of a free slot
+ * 
+ * @return Number of allocations
+ */
+unsigned long MessagePool::getNumFailedAllocations(void)
+{
+	return this->numFailedAllocations;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Settings.h"
+#include "Message.h"
+
+/**
+ * A handle names a slot of the MessagePool. It is all a MessageQueue stores.
+ */
+typedef uint8_t messageHandle;
+#define MESSAGE_HANDLE_NONE (0xFF)
+
+/**
+ * @brief A MessagePool is a fixed slab of messages shared by every MessageQueue. A message is 
+ * written into a slot once, and every queue holding it holds only its handle. Each holder counts 
+ * as a reference, and the slot is free again once the last is released. Each slot is stamped with 
+ * the time it was written, so queues may age out what they hold. Size specified in "Settings.h".
+ * 
+ */
+class MessagePool
+{
+private:
+	Message slots[MESSAGE_POOL_SIZE];
+	uint8_t numReferences[MESSAGE_POOL_SIZE];
+	time_ms stamps[MESSAGE_POOL_SIZE]; // time of allocation
+
+	/**
+	 * Allocations refused for lack of a free slot
+	 */
+	unsigned long numFailedAllocations;
+
+public:
+	MessagePool(void) : numFailedAllocations(0)
+	{
+		memorySet(numReferences, 0, sizeof(numReferences));
+	}
+
+	messageHandle allocate(void);
+	Message* get(messageHandle handle);
+	time_ms getAge(messageHandle handle);
+	void retain(messageHandle handle);
+	void release(messageHandle handle);
+	uint8_t getNumFreeSlots(void);
+	unsigned long getNumFailedAllocations(void);
+};
+
+/**
+ * One pool per board
+ */
+extern MessagePool g_messagePool;
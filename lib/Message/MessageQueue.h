@@ -1,9 +1,11 @@
 #pragma once
 #include "Message.h"
+#include "MessagePool.h"
 
 /**
- * Return codes. Queue existence and type validation is performed by MessageQueueHub
+ * Return codes. Queues are stored, and types validated, by MessageQueueHub
  */
+#define RET_ENQUEUE_POOL_IS_EMPTY (-4)
 #define RET_ENQUEUE_NO_QUEUE (-3)
 #define RET_ENQUEUE_QUEUE_IS_FULL (-2)
 #define RET_ENQUEUE_DISALLOWED_TYPE (-1)
@@ -20,104 +22,80 @@
 
 
 /**
- * @brief A generic MessageQueue-type object that real MessageQueue objects inherit for 
- * polymorphism simplicity. This provides a general pointer to a non-templated MessageQueue
+ * @brief Queue policies, declared per type in a MessageTypes list, e.g.
+ * MessageTypes<Fifo<MessageType::X, 4>, Mailbox<MessageType::Y>>. Either may be wrapped in 
+ * Expiring to give it a time to live, and in Weighted to schedule its pickup. Queued messages are held in 
+ * the MessagePool, and a queue holds only a handle to each.
  * 
+ * A Fifo holds up to depth messages in order of arrival, and reports full beyond that.
+ * 
+ * @tparam messageType 
+ * @tparam queueDepth Messages held, default MESSAGE_QUEUE_SIZE
  */
-class MessageQueueGeneric
+template <MessageType messageType, uint8_t queueDepth = MESSAGE_QUEUE_SIZE>
+struct Fifo
 {
-protected:
-	/**
-	 * Number of total messages that can be stored in the queue
-	 */
-	Message queue[MESSAGE_QUEUE_SIZE];
-	size_t head;
-	size_t tail;
-
-public:
-	MessageQueueGeneric(void) : head(0), tail(0) {};
-    virtual ~MessageQueueGeneric() = default;
-	
-	/**
-	 * @brief Check if messages stored in queue
-	 * 
-	 * @return If no messages in queue
-	 */
-	bool isEmpty(void) const
-	{
-		return head == tail;
-	}
-	
-	/**
-	 * @brief Check if any space left for more messages in queue
-	 * 
-	 * @return If queue is full with no space with for new messages
-	 */
-	bool isFull(void) const
-	{
-		return ((head + 1) % (size_t)MESSAGE_QUEUE_SIZE) == tail;
-	}
-
-	/**
-	 * @brief Clear the queue
-	 * 
-	 */
-	void clear(void)
-	{
-		head = 0;
-		tail = 0;
-	}
+	static_assert(queueDepth > 0, "Fifo depth must be at least 1");
+	static constexpr MessageType type = messageType;
+	static constexpr uint8_t depth = queueDepth;
+	static constexpr bool isMailbox = false;
+	static constexpr time_ms ttl = 0; // never expires
+	static constexpr uint8_t weight = 0; // unweighted
+};
 
-    virtual int enqueue(Message* message) = 0;
-    virtual int dequeue(Message* message) = 0;
+/**
+ * @brief A Mailbox holds only the latest message. It never reports full, as a new message 
+ * replaces the one held. Suited to commands and requests where only the freshest matters.
+ * 
+ * @tparam messageType 
+ */
+template <MessageType messageType>
+struct Mailbox
+{
+	static constexpr MessageType type = messageType;
+	static constexpr uint8_t depth = 1;
+	static constexpr bool isMailbox = true;
+	static constexpr time_ms ttl = 0; // never expires
+	static constexpr uint8_t weight = 0; // unweighted
 };
 
 /**
- * @brief A MessageQueue will store a buffer of Messages of one specific type. Typing is enforced 
- * on enqueue. This is treated as a memory dump, so messages are not initialized on enqueue or 
- * dequeue, but rather memoryCopy is used for the whole message. It is assumed the message is 
- * initialized on enqueue.
+ * @brief Age out a Fifo or Mailbox. A message held longer than timeToLive since it was received 
+ * is stale, and is dropped when the queue is next read rather than returned, e.g. 
+ * Expiring<Mailbox<MessageType::X>, 100UL>.
  * 
- * @tparam allowedType 
+ * @tparam queueSpec Fifo or Mailbox
+ * @tparam timeToLive Millis a message is fresh for
  */
-template <MessageType allowedType>
-class MessageQueue : public MessageQueueGeneric
+template <typename queueSpec, time_ms timeToLive>
+struct Expiring
 {
-public:
-	/**
-	 * @brief Enqueue a new message
-	 * 
-	 * @param message Pointer with data to enqueue
-	 * @return RET_ENQUEUE_QUEUE_IS_FULL if no space in queue
-	 * 		   RET_ENQUEUE_DISALLOWED_TYPE if provided message is incorrect type
-	 *         RET_ENQUEUE_SUCCESS otherwise.
-	 */
-	int enqueue(Message* message)
-	{
-		if (this->isFull()) return RET_ENQUEUE_QUEUE_IS_FULL;
-		// Enforce message is of correct type
-		if (message->getType() != allowedType) return RET_ENQUEUE_DISALLOWED_TYPE;
-		// Copy data into queue
-		memoryCopy(&(queue[head]), message, sizeof(*message));
-		// Move head
-		head = (head + 1) % (size_t)MESSAGE_QUEUE_SIZE;
-		return RET_ENQUEUE_SUCCESS;
-	}
+	static_assert(timeToLive > 0, "Expiring time to live must be at least 1 ms");
+	static constexpr MessageType type = queueSpec::type;
+	static constexpr uint8_t depth = queueSpec::depth;
+	static constexpr bool isMailbox = queueSpec::isMailbox;
+	static constexpr time_ms ttl = timeToLive;
+	static constexpr uint8_t weight = queueSpec::weight;
+};
 
-	/**
-	 * @brief Dequeue a message
-	 * 
-	 * @param message Pointer to dequeue into
-	 * @return RET_DEQUEUE_QUEUE_IS_EMPTY if no messages to dequeue
-	 *         RET_DEQUEUE_SUCCESS otherwise.
-	 */
-	int dequeue(Message* message)
-	{
-		if (this->isEmpty()) return RET_DEQUEUE_QUEUE_IS_EMPTY;
-		// Copy data into message
-		memoryCopy(message, &(queue[tail]), sizeof(queue[tail]));
-		// Move tail
-		tail = (tail + 1) % (size_t)MESSAGE_QUEUE_SIZE;
-		return RET_DEQUEUE_SUCCESS;
-	}
-};
\ No newline at end of file
+/**
+ * @brief Weight a Fifo or Mailbox, possibly Expiring, for pickup from messagesOut. If any output 
+ * type of a controller is weighted, pickup visits the queues of each MessagePriority in turn, 
+ * taking up to weight messages from each before moving on. Unweighted types then take 1. 
+ * Otherwise pickup takes from the first non-empty queue in declaration order, e.g. 
+ * Weighted<Fifo<MessageType::X>, 2>. Weights only share out a class, so are only worth 
+ * declaring between types of the same MessagePriority.
+ * 
+ * @tparam queueSpec Fifo, Mailbox or Expiring
+ * @tparam queueWeight Messages taken per turn
+ */
+template <typename queueSpec, uint8_t queueWeight>
+struct Weighted
+{
+	static_assert(queueWeight > 0, "Weighted weight must be at least 1");
+	static constexpr MessageType type = queueSpec::type;
+	static constexpr uint8_t depth = queueSpec::depth;
+	static constexpr bool isMailbox = queueSpec::isMailbox;
+	static constexpr time_ms ttl = queueSpec::ttl;
+	static constexpr uint8_t weight = queueWeight;
+};
@@ -1,52 +1,243 @@
 #pragma once
 #include "MessageQueue.h"
 
+/*****************************************************
+ *                 COMPILER UTILITIES                *
+ *****************************************************/
+#define QUEUE_SLOT_NONE (0xFF)
+
+/**
+ * @brief Find the slot of a MessageType within a list of MessageType values, at compile time
+ * 
+ * @return Slot, or QUEUE_SLOT_NONE if not in list
+ */
+constexpr uint8_t queueSlotOf(MessageType, uint8_t)
+{
+	return QUEUE_SLOT_NONE;
+}
+
+template <typename... Rest>
+constexpr uint8_t queueSlotOf(MessageType type, uint8_t slot, MessageType first, Rest... rest)
+{
+	return (first == type) ? slot : queueSlotOf(type, slot + 1, rest...);
+}
+
+/**
+ * @brief Find the first handle of a queue slot, given every queue depth in slot order
+ * 
+ */
+constexpr uint8_t queueOffsetOf(uint8_t)
+{
+	return 0;
+}
+
+template <typename... Rest>
+constexpr uint8_t queueOffsetOf(uint8_t slot, uint8_t firstDepth, Rest... rest)
+{
+	return (slot == 0) ? 0 : firstDepth + queueOffsetOf(slot - 1, rest...);
+}
+
+/**
+ * @brief Sum every queue depth
+ * 
+ */
+constexpr uint8_t queueDepthSum(void)
+{
+	return 0;
+}
+
+template <typename... Rest>
+constexpr uint8_t queueDepthSum(uint8_t firstDepth, Rest... rest)
+{
+	return firstDepth + queueDepthSum(rest...);
+}
+
+/**
+ * @brief Check if any queue weight is set
+ * 
+ */
+constexpr bool queueWeightAny(void)
+{
+	return false;
+}
+
+template <typename... Rest>
+constexpr bool queueWeightAny(uint8_t firstWeight, Rest... rest)
+{
+	return (firstWeight != 0) || queueWeightAny(rest...);
+}
+
+/**
+ * @brief A sequence 0 to N - 1, to expand over every MessageType or every queue slot
+ * 
+ */
+template <uint8_t... indices>
+struct IndexSequence {};
+
+template <uint8_t N, uint8_t... indices>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, indices...> {};
+
+template <uint8_t... indices>
+struct MakeIndexSequence<0, indices...>
+{
+	typedef IndexSequence<indices...> type;
+};
+
 /**
- * @brief Helper struct to hold a single MessageQueue
+ * @brief A dense index from every MessageType to its queue slot, built at compile time. It is 
+ * indexed at runtime, so it is kept in PROGMEM rather than copied into SRAM, and read with 
+ * pgm_read_byte.
  * 
- * @tparam allowedType
+ * @tparam indices Every MessageType value
+ * @tparam allowedTypes MessageType values with a queue, in slot order
  */
-template <MessageType allowedType>
-struct QueueHolder
+template <typename indices, MessageType... allowedTypes>
+struct QueueSlotIndex;
+
+template <uint8_t... indices, MessageType... allowedTypes>
+struct QueueSlotIndex<IndexSequence<indices...>, allowedTypes...>
 {
-    MessageQueue<allowedType> queue;
-    MessageQueueGeneric* getGenericQueue() { return &queue; }
+	static constexpr uint8_t slots[sizeof...(indices)] PROGMEM = {
+		queueSlotOf((MessageType)indices, 0, allowedTypes...)...
+	};
 };
 
+template <uint8_t... indices, MessageType... allowedTypes>
+constexpr uint8_t QueueSlotIndex<IndexSequence<indices...>, allowedTypes...>::slots[sizeof...(indices)] PROGMEM;
+
 /**
- * @brief A MessageQueueHub stores a list of MessageQueues for a given list of MessageType values.
- * A forward declaration implementing the MessageTypes template is required so that MessageQueueHub 
- * can then be directly initialzied from a list of MessageType values.
+ * @brief The depth, policy, time to live, pickup weight, priority class and place in the shared 
+ * handle array of every queue slot, built at compile time. The tables are indexed by slot at 
+ * runtime, so they are kept in PROGMEM and read with the pgm_read functions.
  * 
- * @tparam allowedTypes 
+ * @tparam slots Every queue slot
+ * @tparam specs Queue policies, in slot order
  */
-template <MessageType... allowedTypes>
-class MessageQueueHub : private QueueHolder<allowedTypes>...
+template <typename slots, typename... specs>
+struct QueueLayout;
+
+template <uint8_t... slots, typename... specs>
+struct QueueLayout<IndexSequence<slots...>, specs...>
+{
+	static constexpr uint8_t depths[sizeof...(specs)] PROGMEM = { specs::depth... };
+	static constexpr uint8_t offsets[sizeof...(specs)] PROGMEM = { queueOffsetOf(slots, specs::depth...)... };
+	static constexpr bool isMailbox[sizeof...(specs)] PROGMEM = { specs::isMailbox... };
+	static constexpr time_ms ttls[sizeof...(specs)] PROGMEM = { specs::ttl... };
+	static constexpr uint8_t weights[sizeof...(specs)] PROGMEM = { 
+		((specs::weight != 0) ? specs::weight : (uint8_t)1)... 
+	};
+	static constexpr MessagePriority priorities[sizeof...(specs)] PROGMEM = { 
+		messagePriorityOf(specs::type)... 
+	};
+	static constexpr uint8_t numHandles = queueDepthSum(specs::depth...);
+	static constexpr bool isWeighted = queueWeightAny(specs::weight...);
+};
+
+template <uint8_t... slots, typename... specs>
+constexpr uint8_t QueueLayout<IndexSequence<slots...>, specs...>::depths[sizeof...(specs)] PROGMEM;
+template <uint8_t... slots, typename... specs>
+constexpr uint8_t QueueLayout<IndexSequence<slots...>, specs...>::offsets[sizeof...(specs)] PROGMEM;
+template <uint8_t... slots, typename... specs>
+constexpr bool QueueLayout<IndexSequence<slots...>, specs...>::isMailbox[sizeof...(specs)] PROGMEM;
+template <uint8_t... slots, typename... specs>
+constexpr time_ms QueueLayout<IndexSequence<slots...>, specs...>::ttls[sizeof...(specs)] PROGMEM;
+template <uint8_t... slots, typename... specs>
+constexpr uint8_t QueueLayout<IndexSequence<slots...>, specs...>::weights[sizeof...(specs)] PROGMEM;
+template <uint8_t... slots, typename... specs>
+constexpr MessagePriority QueueLayout<IndexSequence<slots...>, specs...>::priorities[sizeof...(specs)] PROGMEM;
+
+/**
+ * @brief A MessageQueueHub stores a queue for each of a list of MessageType queue policies. Each 
+ * MessageType is placed in a queue slot, found through a dense index so every operation is a 
+ * single array index. All queues share one array of handles, each taking only its own depth.
+ * 
+ * @tparam specs Fifo or Mailbox of each MessageType, optionally Expiring or Weighted
+ */
+template <typename... specs>
+class MessageQueueHub
 {
 private:
-    static constexpr MessageType types[sizeof...(allowedTypes)] = { allowedTypes... };
+	static constexpr uint8_t numQueues = sizeof...(specs);
+
+	typedef QueueSlotIndex<
+		typename MakeIndexSequence<(uint8_t)MessageType::Count>::type, 
+		specs::type...
+	> SlotIndex;
+	typedef QueueLayout<typename MakeIndexSequence<numQueues>::type, specs...> Layout;
 
 	/**
-	 * @brief Get the pointer to the included MessageQueue of desired MessageType
+	 * Handles of queued messages. Each queue is a ring of its depth, starting at its offset.
+	 */
+	messageHandle handles[Layout::numHandles];
+	uint8_t heads[numQueues]; // oldest message
+	uint8_t counts[numQueues];
+
+	/**
+	 * @brief Read the layout of a queue slot from flash
 	 * 
-	 * @param desiredType MessageType of queue
-	 * @return auto Pointer to MessageQueue, or NULL if none found.
-	 */
-    MessageQueueGeneric* locateQueueByType(MessageType desiredType)
-    {
-        // Expand over all allowed types and check each
-        MessageQueueGeneric* result = nullptr;
-        using expander = int[];
-        (void)expander{0, (
-			(allowedTypes == desiredType ? (
-				result = QueueHolder<allowedTypes>::getGenericQueue()
-			) : nullptr), 
-			0)...
-		};
-        return result;
-    }
+	 */
+	static uint8_t getDepth(uint8_t slot) { return pgm_read_byte(&Layout::depths[slot]); }
+	static uint8_t getOffset(uint8_t slot) { return pgm_read_byte(&Layout::offsets[slot]); }
+	static bool getIsMailbox(uint8_t slot) { return pgm_read_byte(&Layout::isMailbox[slot]); }
+	static time_ms getTtl(uint8_t slot) { return pgm_read_dword(&Layout::ttls[slot]); }
+
+	/**
+	 * @brief Check if a queue cannot take another message. A Mailbox never is.
+	 * 
+	 */
+	bool isFull(uint8_t slot) const
+	{
+		return (counts[slot] == getDepth(slot)) && (false == getIsMailbox(slot));
+	}
+
+	/**
+	 * @brief Hold a handle whose reference is already counted, replacing the oldest in a full 
+	 * Mailbox
+	 * 
+	 */
+	void push(uint8_t slot, messageHandle handle)
+	{
+		uint8_t depth = getDepth(slot);
+		uint8_t offset = getOffset(slot);
+		if (counts[slot] == depth)
+		{
+			// Latest value wins
+			g_messagePool.release(handles[offset + heads[slot]]);
+			heads[slot] = (heads[slot] + 1) % depth;
+			counts[slot]--;
+		}
+		handles[offset + ((heads[slot] + counts[slot]) % depth)] = handle;
+		counts[slot]++;
+	}
+
+	/**
+	 * @brief Take the oldest handle, whose reference passes to the caller
+	 * 
+	 */
+	messageHandle pop(uint8_t slot)
+	{
+		messageHandle handle = handles[getOffset(slot) + heads[slot]];
+		heads[slot] = (heads[slot] + 1) % getDepth(slot);
+		counts[slot]--;
+		return handle;
+	}
+
+	/**
+	 * @brief Check if a held message has outlived the time to live of its queue
+	 * 
+	 */
+	bool isStale(uint8_t slot, messageHandle handle) const
+	{
+		time_ms ttl = getTtl(slot);
+		return (ttl != 0) && (g_messagePool.getAge(handle) > ttl);
+	}
+
 public:
-    MessageQueueHub() = default;
+    MessageQueueHub()
+	{
+		memorySet(heads, 0, sizeof(heads));
+		memorySet(counts, 0, sizeof(counts));
+	}
     ~MessageQueueHub() = default;
 
 	/**
@@ -54,26 +245,121 @@ public:
 	 * 
 	 * @return If this is an empty hub with no queues.
 	 */
-	static constexpr bool hasNoQueues(void) { return (sizeof...(allowedTypes) == 0); }
+	static constexpr bool hasNoQueues(void) { return false; }
+
+	/**
+	 * @brief Get the number of queue slots
+	 * 
+	 */
+	static constexpr uint8_t getNumQueues(void) { return numQueues; }
+
+	/**
+	 * @brief Check if pickup should be scheduled by weight rather than in slot order
+	 * 
+	 */
+	static constexpr bool isWeighted(void) { return Layout::isWeighted; }
+
+	/**
+	 * @brief Get the pickup weight of a queue slot, at least 1
+	 * 
+	 */
+	static uint8_t getWeight(uint8_t slot) { return pgm_read_byte(&Layout::weights[slot]); }
+
+	/**
+	 * @brief Get the priority class of the MessageType of a queue slot
+	 * 
+	 */
+	static MessagePriority getPriority(uint8_t slot) 
+	{ 
+		return (MessagePriority)pgm_read_byte(&Layout::priorities[slot]); 
+	}
+
+	/**
+	 * @brief Check if a queue slot holds no messages
+	 * 
+	 */
+	bool isEmpty(uint8_t slot) const { return counts[slot] == 0; }
+
+	/**
+	 * @brief Get the queue slot of desired MessageType
+	 * 
+	 * @param desiredType MessageType of queue
+	 * @return Slot, or QUEUE_SLOT_NONE if none found.
+	 */
+	uint8_t locateSlotByType(MessageType desiredType) const
+	{
+		uint8_t type = (uint8_t)desiredType;
+		if (type >= (uint8_t)MessageType::Count) return QUEUE_SLOT_NONE;
+		return pgm_read_byte(&SlotIndex::slots[type]);
+	}
 
 	/**
-	 * @brief Enqueue a message, if a valid queue for its MessageType exists
+	 * @brief Dequeue from a queue slot, dropping stale messages ahead of the first fresh one
+	 * 
+	 */
+	int dequeueSlot(uint8_t slot, Message* message)
+	{
+		while (counts[slot] > 0)
+		{
+			messageHandle handle = this->pop(slot);
+			if (this->isStale(slot, handle))
+			{
+				g_messagePool.release(handle);
+				continue;
+			}
+
+			// Copy data into message and release reference
+			memoryCopy(message, g_messagePool.get(handle), sizeof(*message));
+			g_messagePool.release(handle);
+			return RET_DEQUEUE_SUCCESS;
+		}
+		return RET_DEQUEUE_QUEUE_IS_EMPTY;
+	}
+
+	/**
+	 * @brief Enqueue a message, copying it into the MessagePool, if a valid queue for its 
+	 * MessageType exists
 	 * 
 	 * @param message 
 	 * @return See MessageQueue.h
 	 */
 	int enqueue(Message* message)
 	{
-		// Verify queues exist
-		if (hasNoQueues()) return RET_ENQUEUE_NO_QUEUE;
+		// Verify queue of this type exists
+		uint8_t slot = locateSlotByType(message->getType());
+		if (slot == QUEUE_SLOT_NONE) return RET_ENQUEUE_DISALLOWED_TYPE;
+		if (this->isFull(slot)) return RET_ENQUEUE_QUEUE_IS_FULL;
 
+		// Copy data into pool
+		messageHandle handle = g_messagePool.allocate();
+		if (handle == MESSAGE_HANDLE_NONE) return RET_ENQUEUE_POOL_IS_EMPTY;
+		memoryCopy(g_messagePool.get(handle), message, sizeof(*message));
+
+		// Hold allocated reference
+		this->push(slot, handle);
+		return RET_ENQUEUE_SUCCESS;
+	}
+
+	/**
+	 * @brief Enqueue a message already in the MessagePool, adding a reference to it, if a valid 
+	 * queue for its MessageType exists
+	 * 
+	 * @param handle 
+	 * @return See MessageQueue.h
+	 */
+	int enqueue(messageHandle handle)
+	{
 		// Verify queue of this type exists
-		MessageType desiredType = message->getType();
-		auto queue = locateQueueByType(desiredType);
-		if (queue == nullptr) return RET_ENQUEUE_DISALLOWED_TYPE;
+		Message* message = g_messagePool.get(handle);
+		if (message == NULL) return RET_ENQUEUE_DISALLOWED_TYPE;
+		uint8_t slot = locateSlotByType(message->getType());
+		if (slot == QUEUE_SLOT_NONE) return RET_ENQUEUE_DISALLOWED_TYPE;
+		if (this->isFull(slot)) return RET_ENQUEUE_QUEUE_IS_FULL;
 
-		// Enqueue
-		return queue->enqueue(message);
+		// Hold a reference
+		g_messagePool.retain(handle);
+		this->push(slot, handle);
+		return RET_ENQUEUE_SUCCESS;
 	}
 
 	/**
@@ -85,31 +371,52 @@ public:
 	 */
 	int dequeue(const MessageType desiredType, Message* message)
 	{
-		if (hasNoQueues()) return RET_DEQUEUE_NO_QUEUE;
-
 		// Verify queue of this type exists
-		MessageQueueGeneric* queue = locateQueueByType(desiredType);
-		if (queue == nullptr) return RET_DEQUEUE_DISALLOWED_TYPE;
+		uint8_t slot = locateSlotByType(desiredType);
+		if (slot == QUEUE_SLOT_NONE) return RET_DEQUEUE_DISALLOWED_TYPE;
 
 		// Dequeue
-		return queue->dequeue(message);
+		return this->dequeueSlot(slot, message);
 	}
 
 	/**
-	 * @brief Clear the whole queue, if a valid queue for this MessageType exists
+	 * @brief Clear the whole queue, releasing every message held, if a valid queue for this 
+	 * MessageType exists
 	 * 
 	 * @return See MessageQueue.h
 	 */
 	int clear(const MessageType desiredType)
 	{
-		if (hasNoQueues()) return RET_CLEAR_NO_QUEUE;
-		
 		// Verify queue of this type exists
-		MessageQueueGeneric* queue = locateQueueByType(desiredType);
-		if (queue == nullptr) return RET_CLEAR_DISALLOWED_TYPE;
+		uint8_t slot = locateSlotByType(desiredType);
+		if (slot == QUEUE_SLOT_NONE) return RET_CLEAR_DISALLOWED_TYPE;
 
 		// Clear
-		queue->clear();
+		while (counts[slot] > 0)
+			g_messagePool.release(this->pop(slot));
+		heads[slot] = 0;
 		return RET_CLEAR_SUCCESS;
 	}
 };
+
+/**
+ * @brief An empty MessageQueueHub holds no queues, and every operation fails.
+ * 
+ */
+template <>
+class MessageQueueHub<>
+{
+public:
+	static constexpr bool hasNoQueues(void) { return true; }
+	static constexpr uint8_t getNumQueues(void) { return 0; }
+	static constexpr bool isWeighted(void) { return false; }
+	static uint8_t getWeight(uint8_t) { return 0; }
+	static MessagePriority getPriority(uint8_t) { return MessagePriority::Count; }
+	bool isEmpty(uint8_t) const { return true; }
+	uint8_t locateSlotByType(MessageType) const { return QUEUE_SLOT_NONE; }
+	int dequeueSlot(uint8_t, Message*) { return RET_DEQUEUE_NO_QUEUE; }
+	int enqueue(Message*) { return RET_ENQUEUE_NO_QUEUE; }
+	int enqueue(messageHandle) { return RET_ENQUEUE_NO_QUEUE; }
+	int dequeue(const MessageType, Message*) { return RET_DEQUEUE_NO_QUEUE; }
+	int clear(const MessageType) { return RET_CLEAR_NO_QUEUE; }
+};
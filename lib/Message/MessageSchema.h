@@ -0,0 +1,249 @@
+#pragma once
+/* Generated by scripts/generate_messages.py from schema/messages.json. Do not edit. */
+#include "Types.h"
+
+/*****************************************************
+ *                   MESSAGE TYPES                   *
+ *****************************************************/
+
+/**
+ * @brief Define all possible Message types.
+ * Every Message object will begin with a char denoting the type of message
+ * 
+ */
+enum class MessageType {
+	Unused, // encodes to 0
+	Generic,
+	Error,
+	DrivetrainManualCommand,
+	DrivetrainManualResponse,
+	DrivetrainAutomatedCommand,
+	DrivetrainAutomatedResponse,
+	DrivetrainEncoderState,
+	DrivetrainEncoderDistances,
+	DrivetrainDisplacements,
+	DrivetrainMotorCommand,
+	DrivetrainEncoderTicks,
+	DrivetrainDisplacementsFixed,
+	DrivetrainMotorCommandFixed,
+	LidarState,
+	LidarPointReading,
+	LidarScanChunk,
+	LidarScanChunkCompact,
+	UltrasonicState,
+	UltrasonicPointReading,
+	GripperCommand,
+	GripperState,
+	LinkControl, // stays between the boards, never forwarded
+	LoopTimeHistogram,
+	EchoFilter, // host to controller board, types of peripheral messages not echoed
+	DiagnosticsCounters, // counts since startup of traffic each board passed over or lost
+
+	Count
+};
+
+/**
+ * @brief Classes of outbound traffic, in order of transmit priority. Every queued message of a 
+ * class is collected before any of the next.
+ * 
+ */
+enum class MessagePriority : uint8_t {
+	Control, // commands and their acknowledgements, which must keep a bounded latency
+	Response, // replies to requests and state changes
+	Bulk, // sensor streams, which fill the remaining bandwidth
+
+	Count
+};
+
+/**
+ * @brief Get the priority class of a MessageType
+ * 
+ */
+constexpr MessagePriority messagePriorityOf(MessageType type)
+{
+	return
+		(
+			(type == MessageType::Error) ||
+			(type == MessageType::DrivetrainManualCommand) ||
+			(type == MessageType::DrivetrainManualResponse) ||
+			(type == MessageType::DrivetrainAutomatedCommand) ||
+			(type == MessageType::DrivetrainAutomatedResponse) ||
+			(type == MessageType::DrivetrainEncoderState) ||
+			(type == MessageType::GripperCommand) ||
+			(type == MessageType::LinkControl)
+		) ? MessagePriority::Control :
+		(
+			(type == MessageType::DrivetrainMotorCommand) ||
+			(type == MessageType::DrivetrainMotorCommandFixed) ||
+			(type == MessageType::LidarPointReading) ||
+			(type == MessageType::LidarScanChunk) ||
+			(type == MessageType::LidarScanChunkCompact) ||
+			(type == MessageType::LoopTimeHistogram) ||
+			(type == MessageType::DiagnosticsCounters)
+		) ? MessagePriority::Bulk :
+		MessagePriority::Response;
+}
+
+/**
+ * @brief Whether a MessageType stays between the two boards of a link, rather than being 
+ * addressed to the host
+ * 
+ */
+constexpr bool messageIsLinkLocal(MessageType type)
+{
+	return (type == MessageType::LinkControl);
+}
+
+/*****************************************************
+ *                       ENUMS                       *
+ *****************************************************/
+
+/**
+ * Valid commands to be issued to the drivetrain under manual control.
+ */
+enum class DrivetrainManualCommand
+{
+	Invalid,
+	NoReceived,
+	TranslateForward,
+	TranslateBackward,
+	RotateLeft,
+	RotateRight,
+	Brake,
+	Halt,
+	Automated,
+
+	Count
+};
+
+/**
+ * Valid messages for drivetrain board to issue back under manual control.
+ */
+enum class DrivetrainManualResponse
+{
+	Invalid,
+	NoReceived,
+	Acknowledge,
+	NotifyHalting,
+	NotifyBraking,
+
+	Count
+};
+
+/**
+ * Valid messages for drivetrain board to issue back under automated control
+ */
+enum class DrivetrainAutomatedResponse
+{
+	Invalid,
+	NoReceived,
+	Acknowledge,
+	InProgress,
+	Overshot,
+	AtTarget,
+	Aborted,
+
+	Count
+};
+
+/**
+ * Valid messages for drivetrain encoder communication
+ */
+enum class DrivetrainEncoderState
+{
+	Invalid,
+	NoReceived,
+	Request,
+
+	Count
+};
+
+/**
+ * Valid messages for Lidar communication
+ */
+enum class LidarState
+{
+	Invalid,
+	NoReceived,
+	Request,
+	RequestKeyframe,
+	Rejected,
+	NotOpen,
+	CannotScan,
+	HealthUnknown,
+	NotHealthy,
+	Success,
+	Complete,
+
+	Count
+};
+
+/**
+ * Valid messages for Ultrasonic communication
+ */
+enum class UltrasonicState
+{
+	Invalid,
+	NoReceived,
+	Request,
+	Rejected,
+	InProgress,
+	Success,
+	Complete,
+
+	Count
+};
+
+/**
+ * Valid commands to be issued to the gripper.
+ */
+enum class GripperCommand
+{
+	Invalid,
+	NoReceived,
+	Home,
+	Extend,
+	Ready,
+	Open,
+	Close,
+	Ping,
+
+	Count
+};
+
+/**
+ * Valid states from the gripper
+ */
+enum class GripperState
+{
+	Invalid,
+	NoReceived,
+	Home,
+	ReadyClosed,
+	ReadyOpened,
+	ExtendedClosed,
+	ExtendedOpened,
+
+	Count
+};
+
+/*****************************************************
+ *                     CONSTANTS                     *
+ *****************************************************/
+
+/**
+ * @brief Scales and gains that the boards and the host both apply to wire values
+ * 
+ */
+#define WHEEL_DIAMETER_IN (2.20472)
+#define WHEEL_CIRCUMFERENCE_IN (2 * PI * WHEEL_DIAMETER_IN)
+#define DEFAULT_ENCODER_TICKS_PER_ROTATION (1000) // approx
+#define DEFAULT_ENCODER_GAIN_IN (WHEEL_CIRCUMFERENCE_IN / DEFAULT_ENCODER_TICKS_PER_ROTATION)
+#define ENCODER_1_TUNING_GAIN (0.485)
+#define ENCODER_2_TUNING_GAIN (0.485)
+#define ENCODER_3_TUNING_GAIN (1.045)
+#define ENCODER_1_TO_IN (DEFAULT_ENCODER_GAIN_IN * ENCODER_1_TUNING_GAIN) // DrivetrainEncoderTicks encoder1Ticks to inches
+#define ENCODER_2_TO_IN (DEFAULT_ENCODER_GAIN_IN * ENCODER_2_TUNING_GAIN) // DrivetrainEncoderTicks encoder2Ticks to inches
+#define ENCODER_3_TO_IN (DEFAULT_ENCODER_GAIN_IN * ENCODER_3_TUNING_GAIN) // DrivetrainEncoderTicks encoder3Ticks to inches
+#define DRIVETRAIN_FIXED_POINT_DISTANCE_SCALE (100) // hundredths of an inch
+#define DRIVETRAIN_FIXED_POINT_ANGLE_SCALE (100) // hundredths of a radian
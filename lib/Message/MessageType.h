@@ -2,45 +2,38 @@
 #include "Types.h"
 
 /**
- * @brief Define all possible Message types.
- * Every Message object will begin with a char denoting the type of message
- * 
+ * MessageType, MessagePriority and the enums sent in messages are generated from 
+ * schema/messages.json into MessageSchema.h
  */
-enum class MessageType {
-	/* Unused */
-	Unused, // encodes to 0
+#include "MessageSchema.h"
 
-	/* Generic Types */
-	Generic,
-    Error,
-
-	/* Drivetrain */
-	DrivetrainManualCommand,
-	DrivetrainManualResponse,
-	DrivetrainAutomatedCommand,
-	DrivetrainAutomatedResponse,
-	DrivetrainEncoderState,
-	DrivetrainEncoderDistances,
-    DrivetrainDisplacements,
-    DrivetrainMotorCommand,
+static_assert((uint8_t)MessageType::Count <= UINT_LEAST8_MAX, "MessageType must be uniquely captured in one byte");
 
-	/* Sensor Readings*/
-	LidarState,
-	LidarPointReading,
-    UltrasonicState,
-    UltrasonicPointReading,
+/**
+ * A set of MessageType values, one bit per type
+ */
+typedef uint32_t messageTypeMask;
+static_assert((uint8_t)MessageType::Count <= 32, "MessageType must be uniquely captured in a messageTypeMask");
 
-    /* Gripper */
-    GripperCommand,
-    GripperState,
+constexpr messageTypeMask messageTypeBit(MessageType type)
+{
+	return ((messageTypeMask)1) << (uint8_t)type;
+}
 
-	Count
-};
+constexpr messageTypeMask messageTypesMask(void)
+{
+	return 0;
+}
 
-static_assert((uint8_t)MessageType::Count <= UINT_LEAST8_MAX, "MessageType must be uniquely captured in one byte");
+template <typename... Rest>
+constexpr messageTypeMask messageTypesMask(MessageType first, Rest... rest)
+{
+	return messageTypeBit(first) | messageTypesMask(rest...);
+}
 
 /**
- * Wrap list of MessageType values into a MessageTypes object.
+ * Wrap list of MessageType queue policies into a MessageTypes object. See Fifo and Mailbox in 
+ * MessageQueue.h.
  */
-template <MessageType... Types>
+template <typename... Specs>
 struct MessageTypes {};
@@ -0,0 +1,31 @@
+#pragma once
+#include "Settings.h"
+#include "MessageType.h"
+
+/**
+ * @brief A read-only view of a message held in place in some other buffer, such as the receive 
+ * ring buffer. The buffer holds the raw form [type][size][content] with content null-terminated. 
+ * Nothing is copied, so the view is only valid until that buffer is released.
+ * 
+ */
+class MessageView
+{
+private:
+	const char* raw;
+
+public:
+	MessageView(void) : raw(NULL) {};
+
+	/**
+	 * @brief Point the view at a raw message
+	 * 
+	 * @param rawBuffer [type][size][content] with content null-terminated
+	 */
+	void init(const char* rawBuffer) { this->raw = rawBuffer; }
+
+	MessageType getType(void) const { return static_cast<MessageType>(raw[0]); }
+	size_t getContentSize(void) const { return (size_t)((uint8_t)raw[1]); }
+	const char* getContent(void) const { return &(raw[MESSAGE_PRE_ENCODE_LENGTH]); }
+	const char* getRaw(void) const { return raw; }
+	size_t getRawSize(void) const { return this->getContentSize() + MESSAGE_ENCODING_LENGTH; }
+};
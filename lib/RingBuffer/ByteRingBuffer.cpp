@@ -0,0 +1,83 @@
+#include "ByteRingBuffer.h"
+
+/**
+ * @brief Get number of bytes waiting to be read
+ */
+size_t ByteRingBuffer::getNumOccupiedBytes(void)
+{
+	return numOccupiedBytes;
+}
+
+/**
+ * @brief Get number of bytes that may be written
+ */
+size_t ByteRingBuffer::getNumFreeBytes(void)
+{
+	return COMMS_TX_BUFFER_SIZE - numOccupiedBytes;
+}
+
+/**
+ * @brief Write a run of bytes. Nothing is written unless the whole run fits.
+ *
+ * @param write_from 
+ * @param size Number of bytes to write
+ * @return RET_WRITE_BYTES_NO_SPACE if the run does not fit,
+ *         RET_WRITE_BYTES_SUCCESS otherwise.
+ */
+int ByteRingBuffer::writeIntoBuffer(const char* write_from, const size_t size)
+{
+	if (size > this->getNumFreeBytes())
+		return RET_WRITE_BYTES_NO_SPACE;
+
+	size_t tail = (head + numOccupiedBytes) % COMMS_TX_BUFFER_SIZE;
+	for (size_t i = 0; i < size; i++)
+	{
+		buffer[tail] = write_from[i];
+		tail = (tail + 1) % COMMS_TX_BUFFER_SIZE;
+	}
+	numOccupiedBytes += size;
+
+	return RET_WRITE_BYTES_SUCCESS;
+}
+
+/**
+ * @brief Write one byte past the occupied bytes, without making it readable. The caller must 
+ * have checked there are at least offset + 1 free bytes.
+ *
+ * @param offset Position past the last occupied byte
+ * @param write_from 
+ */
+void ByteRingBuffer::writeUncommittedByte(const size_t offset, const char write_from)
+{
+	buffer[(head + numOccupiedBytes + offset) % COMMS_TX_BUFFER_SIZE] = write_from;
+}
+
+/**
+ * @brief Make uncommitted bytes readable, in the order of their offsets
+ *
+ * @param size Number of bytes to commit, at most the number of free bytes
+ */
+void ByteRingBuffer::commitBytes(const size_t size)
+{
+	numOccupiedBytes += min(size, this->getNumFreeBytes());
+}
+
+/**
+ * @brief Read and remove the oldest bytes
+ *
+ * @param read_into Of minimum size maxSize
+ * @param maxSize Maximum number of bytes to read
+ * @return Number of bytes read
+ */
+size_t ByteRingBuffer::readFromBuffer(char* read_into, const size_t maxSize)
+{
+	size_t size = min(maxSize, numOccupiedBytes);
+	for (size_t i = 0; i < size; i++)
+	{
+		read_into[i] = buffer[head];
+		head = (head + 1) % COMMS_TX_BUFFER_SIZE;
+	}
+	numOccupiedBytes -= size;
+
+	return size;
+}
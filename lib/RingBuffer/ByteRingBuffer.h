@@ -0,0 +1,34 @@
+#pragma once
+#include "Types.h"
+#include "Settings.h"
+#include "MemoryUtilities.h"
+
+/**
+ * Return codes
+ */
+#define RET_WRITE_BYTES_NO_SPACE (-1)
+#define RET_WRITE_BYTES_SUCCESS (0)
+
+/**
+ * @brief A ring of bytes, written and read in whole runs. Used to hold encoded frames waiting to 
+ * transmit. Size specified in "Settings.h".
+ * 
+ * A run may also be built in place past the occupied bytes, then committed once complete. It is 
+ * not readable until committed.
+ */
+class ByteRingBuffer
+{
+private:
+	char buffer[COMMS_TX_BUFFER_SIZE];
+	size_t head; // next byte to read
+	size_t numOccupiedBytes;
+public:
+	ByteRingBuffer() : head(0), numOccupiedBytes(0) {}
+
+	size_t getNumOccupiedBytes(void);
+	size_t getNumFreeBytes(void);
+	int writeIntoBuffer(const char* write_from, const size_t size);
+	void writeUncommittedByte(const size_t offset, const char write_from);
+	void commitBytes(const size_t size);
+	size_t readFromBuffer(char* read_into, const size_t maxSize);
+};
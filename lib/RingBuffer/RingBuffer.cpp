@@ -17,73 +17,56 @@ uint8_t RingBuffer::getNumOccupiedBuffers(void)
 }
 
 /**
- * @brief Pop (read) the oldest complete message from the ring buffer.
+ * @brief Get the oldest complete message in place. It stays in the ring buffer, and may be 
+ * modified, until released.
  *
- * @param read_into Pointer to external buffer where message will be copied.
- * @return RET_READ_BUFFER_NONE_TO_READ if no buffers are ready,
- *         RET_READ_BUFFER_SUCCESS otherwise.
+ * @return Pointer to the oldest buffer ready to read, or NULL if none are ready
  */
-int RingBuffer::popBuffer(char* read_into)
+char* RingBuffer::peekBuffer(void)
 {
     if (numOccupiedBuffers == 0)
-        return RET_READ_BUFFER_NONE_TO_READ;
+        return NULL;
 
     // Calculate the index of the oldest occupied buffer
     uint8_t oldestBuffer = (MESSAGE_NUM_BUFFERS + currentBuffer - numOccupiedBuffers) % MESSAGE_NUM_BUFFERS;
+    return buffers[oldestBuffer];
+}
 
-    // Copy message to the provided output buffer
-    memoryCopy(read_into, buffers[oldestBuffer], STRING_LENGTH_MAX);
-
-	// Clear buffer
-	memorySet(buffers[oldestBuffer], 0, STRING_LENGTH_MAX);
-
-    // Decrement the number of occupied buffers
-    numOccupiedBuffers--;
-
-    return RET_READ_BUFFER_SUCCESS;
+/**
+ * @brief Release the oldest complete message, freeing its buffer to be written.
+ */
+void RingBuffer::releaseBuffer(void)
+{
+    if (numOccupiedBuffers > 0)
+        numOccupiedBuffers--;
 }
 
 /**
- * @brief Write data into the current active buffer (not yet sealed).
+ * @brief Write one byte into the current active buffer (not yet sealed).
  *
- * @param write_from Null-terminated string to copy into the current buffer.
- * @param size Number of bytes to write
+ * @param write_from Byte to write
  * @param sealOnEndChar Whether to seal whenever an end char is reached
- * @return RET_WRITE_BUFFER_SUCCESS otherwise.
+ * @return RET_WRITE_BUFFER_FULL if the byte sealed the last free buffer,
+ *         RET_WRITE_BUFFER_SUCCESS otherwise.
  */
-int RingBuffer::writeIntoBuffer(
-	const char* write_from, 
-	const size_t size, 
-	bool sealOnEndChar
-)
+int RingBuffer::writeIntoBuffer(const char write_from, bool sealOnEndChar)
 {
-	size_t remainingBytes = size;
-
-	// Read into buffers until all bytes written
-	while(remainingBytes > 0)
+	// Copy char in and update indices
+	buffers[currentBuffer][numOccupiedBytesInCurrentBuffer] = write_from;
+	numOccupiedBytesInCurrentBuffer++;
+	
+	// Determine if should seal
+	if(
+		((write_from == FRAME_DELIMITER_CHAR) && sealOnEndChar) || 
+		(numOccupiedBytesInCurrentBuffer == STRING_LENGTH_MAX - 1)
+	)
 	{
-		// Check if this is an end char
-		bool encounteredEndChar = (*write_from) == MESSAGE_END_CHAR;
-
-		// Copy char in and update indices
-		buffers[currentBuffer][numOccupiedBytesInCurrentBuffer] = *write_from;
-		numOccupiedBytesInCurrentBuffer++;
-		write_from++;
-		remainingBytes--;
-		
-		// Determine if should seal
-		if(
-			(encounteredEndChar && sealOnEndChar) || 
-			(numOccupiedBytesInCurrentBuffer == STRING_LENGTH_MAX - 1)
-		)
-		{
-			sealBuffer();
-			if (isFull())
-				return remainingBytes;
-		}
+		sealBuffer();
+		if (isFull())
+			return RET_WRITE_BUFFER_FULL;
 	}
 
-    return RET_SEAL_BUFFER_SUCCESS;
+    return RET_WRITE_BUFFER_SUCCESS;
 }
 
 /**
@@ -117,3 +100,12 @@ int RingBuffer::sealBuffer(void)
 
     return RET_SEAL_BUFFER_SUCCESS;
 }
+
+/**
+ * @brief Discard the bytes written into the current buffer since it was last sealed, such as a 
+ * partial message received before the stream was interrupted.
+ */
+void RingBuffer::discardUnsealed(void)
+{
+	numOccupiedBytesInCurrentBuffer = 0;
+}
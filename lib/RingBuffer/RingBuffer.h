@@ -6,9 +6,7 @@
 /**
  * Return codes
  */
-#define RET_READ_BUFFER_NONE_TO_READ (-1)
-#define RET_READ_BUFFER_SUCCESS (0)
-
+#define RET_WRITE_BUFFER_FULL (-1)
 #define RET_WRITE_BUFFER_SUCCESS (0)
 
 #define RET_SEAL_BUFFER_EMPTY (-1)
@@ -43,6 +41,8 @@ public:
 	}
 
 	bool isFull(void);
-	int popBuffer(char* read_into);
-	int writeIntoBuffer(const char* write_from, const size_t size, bool sealOnEndChar = true);
+	char* peekBuffer(void);
+	void releaseBuffer(void);
+	int writeIntoBuffer(const char write_from, bool sealOnEndChar = true);
+	void discardUnsealed(void);
 };
\ No newline at end of file
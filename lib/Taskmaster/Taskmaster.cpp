@@ -4,54 +4,333 @@
 /**
  * @brief Construct a Taskmaster
  *
- * @param comms
+ * @param ports Every CommsInterface of the board
+ * @param numPorts At most TASKMASTER_NUM_PORTS_MAX, enforced by TASKMASTER_DECLARE
+ * @param addressRoutes For each board address, the index of the port toward it, or 
+ * TASKMASTER_ROUTE_SELF. BOARD_ADDRESS_COUNT entries.
  * @param controllers
- * @param numControllers
+ * @param numControllers At most TASKMASTER_NUM_CONTROLLERS_MAX, enforced by TASKMASTER_DECLARE
  */
 Taskmaster::Taskmaster(
-    CommsInterface *comms,
+    CommsInterface *ports[],
+    size_t numPorts,
+    const uint8_t addressRoutes[],
     ControllerGeneric *controllers[],
-    size_t numControllers) : comms(comms),
+    size_t numControllers) : ports(ports),
+                             numPorts(min(numPorts, (size_t)TASKMASTER_NUM_PORTS_MAX)),
+                             addressRoutes(addressRoutes),
+                             upstream(NULL),
                              controllers(controllers),
-                             numControllers(numControllers),
-                             hasExternalMessage(false) {}; // externalMessage is uninitialized
+                             numControllers(min(numControllers, (size_t)TASKMASTER_NUM_CONTROLLERS_MAX)),
+                             numRelayDropped(0)
+{
+	this->route();
+
+	uint8_t upstreamIndex = this->getPortIndex(BOARD_ADDRESS_HOST);
+	if (upstreamIndex != TASKMASTER_ROUTE_SELF)
+		this->upstream = ports[upstreamIndex];
+}
 
 /**
- * @brief Read CommsInterface for all bytes
+ * @brief Build the routing table from each controller's subscriptions
  * 
  */
-void Taskmaster::receive(void)
+void Taskmaster::route(void)
 {
-	while(comms->receive());
+	for (uint8_t type = 0; type < (uint8_t)MessageType::Count; type++)
+	{
+		this->routes[type] = 0;
+		LOOP_CONTROLLER_IDX(controller_idx)
+		{
+			if (controllers[controller_idx]->getSubscriptions() & messageTypeBit((MessageType)type))
+				this->routes[type] |= (controllerMask)(1 << controller_idx);
+		}
+	}
 }
 
 /**
- * @brief Try to pull a Message from the CommsInterface
+ * @brief Get the port toward a board
  * 
- * @param message Now populated
- * @return If a Message received
+ * @param address Board address
+ * @return Index of port, or TASKMASTER_ROUTE_SELF if this board or unroutable
  */
-bool Taskmaster::poll(Message* message)
+uint8_t Taskmaster::getPortIndex(uint8_t address)
 {
-	return comms->popMessage(message);
+	if (address >= BOARD_ADDRESS_COUNT)
+		return TASKMASTER_ROUTE_SELF;
+	uint8_t portIndex = this->addressRoutes[address];
+	return (portIndex < this->numPorts) ? portIndex : TASKMASTER_ROUTE_SELF;
 }
 
 /**
- * @brief Deliver Message objects to Controller objects
+ * @brief Check if any Controller holds back a frame passing through this board
  * 
- * @param message To deliver
+ * @param type MessageType of the frame
+ * @param destination Board the frame is addressed to
+ * @return Whether the frame is not relayed
  */
-void Taskmaster::dispatch(Message* message)
+bool Taskmaster::isRelaySuppressed(MessageType type, uint8_t destination)
 {
 	LOOP_CONTROLLER_IDX(controller_idx)
 	{
-		ControllerGeneric* controller = controllers[controller_idx];
-		// Message is only delivered if Controller expects to receive this MessageType
+		if (controllers[controller_idx]->isRelaySuppressed(type, destination))
+			return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Copy a message for another board into the MessagePool once, then queue it to be sent 
+ * out of its port and deliver it to any Controller receiving it. Both hold a reference to the 
+ * same slot.
+ * 
+ * @param portIndex Port to send it out of, or TASKMASTER_ROUTE_SELF to only deliver it
+ * @param view 
+ * @param address Frame address to send it with
+ */
+void Taskmaster::hold(uint8_t portIndex, const MessageView* view, frameAddress address)
+{
+	messageHandle handle = g_messagePool.allocate();
+	if (handle == MESSAGE_HANDLE_NONE)
+	{
+		if (portIndex != TASKMASTER_ROUTE_SELF)
+			this->numRelayDropped++;
+		return;
+	}
+	g_messagePool.get(handle)->init(view);
+
+	this->dispatch(handle);
+
+	// Allocated reference passes to the queue
+	if (portIndex != TASKMASTER_ROUTE_SELF)
+		this->relayQueues[portIndex].push(handle, address);
+	else
+		g_messagePool.release(handle);
+}
+
+/**
+ * @brief Pass on a frame addressed to another board, peeking only at its type. It is verified 
+ * in place and relayed still encoded if it may overtake nothing, and only decoded if it must be 
+ * held or a Controller here receives it. Either way its CRC is checked and it is counted by the 
+ * port it was received on.
+ * 
+ * @param from Port the frame was received on
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ * @param address Frame address
+ */
+void Taskmaster::relayFrame(
+	CommsInterface* from, 
+	const char* frame, 
+	size_t frameSize, 
+	frameAddress address
+)
+{
+	MessageType type = framingPeekType(frame, frameSize);
+	uint8_t destination = FRAME_ADDRESS_DESTINATION(address);
+	uint8_t portIndex = this->getPortIndex(destination);
+
+	// Frames routed back to this board, or held back, are not passed on
+	if ((portIndex != TASKMASTER_ROUTE_SELF) && this->isRelaySuppressed(type, destination))
+		portIndex = TASKMASTER_ROUTE_SELF;
+
+	// Relay straight to the port, keeping the order of anything waiting
+	bool isVerified = false;
+	if (
+		TASKMASTER_WILL_RELAY_FRAMES &&
+		(portIndex != TASKMASTER_ROUTE_SELF) &&
+		this->relayQueues[portIndex].isEmpty() &&
+		ports[portIndex]->canSendMessage()
+	)
+	{
+		// A damaged frame goes no further
+		if (false == from->verifyFrame())
+			return;
+		isVerified = true;
+		ports[portIndex]->relayFrame(frame, frameSize);
+		portIndex = TASKMASTER_ROUTE_SELF;
+	}
+
+	// Controllers here may receive what passes through
+	bool isReceived = (
+		((uint8_t)type < (uint8_t)MessageType::Count) && 
+		(this->routes[(uint8_t)type] != 0)
+	);
+	if ((portIndex == TASKMASTER_ROUTE_SELF) && (false == isReceived))
+	{
+		// Frames held back still count toward the link's statistics
+		if (false == isVerified)
+			from->verifyFrame();
+		return;
+	}
+
+	MessageView view;
+	if (false == from->decodeFrame(&view, (false == isVerified)))
+		return;
+	this->hold(portIndex, &view, address);
+}
+
+/**
+ * @brief Dispatch a frame addressed to this board, or pass on a frame addressed to another
+ * 
+ * @param from Port the frame was received on
+ * @param frame Frame, excluding delimiter
+ * @param frameSize Number of bytes in frame, excluding delimiter
+ */
+void Taskmaster::routeFrame(CommsInterface* from, const char* frame, size_t frameSize)
+{
+	// A frame too short to address fails to decode, and is counted there
+	frameAddress address;
+	if (
+		framingPeekAddress(frame, frameSize, &address) &&
+		(FRAME_ADDRESS_DESTINATION(address) != BOARD_ADDRESS_SELF)
+	)
+	{
+		this->relayFrame(from, frame, frameSize, address);
+		return;
+	}
+
+	// Messages are delivered straight from the receive buffer
+	MessageView view;
+	if (from->decodeFrame(&view))
+		this->dispatch(&view);
+}
+
+/**
+ * @brief Read every port for frames, and route each as soon as it arrives, so a port waiting on 
+ * another never stalls. Each port is read for up to TASKMASTER_RECEIVE_BYTE_BUDGET bytes, so a 
+ * port receiving faster than its frames are routed leaves the rest for the next loop rather than 
+ * holding up the loop.
+ * 
+ */
+void Taskmaster::receive(void)
+{
+	LOOP_PORT_IDX(port_idx)
+	{
+		CommsInterface* port = ports[port_idx];
+
+		size_t numBytesReceived = 0;
+		size_t numBytesRead;
+		do
+		{
+			numBytesRead = port->receive();
+			numBytesReceived += numBytesRead;
+
+			// Every frame is moved out of the receive buffer, then released
+			const char* frame;
+			size_t frameSize;
+			while ((frameSize = port->peekFrame(&frame)) > 0)
+			{
+				this->routeFrame(port, frame, frameSize);
+				port->releaseMessage();
+			}
+		} while ((numBytesRead > 0) && (numBytesReceived < TASKMASTER_RECEIVE_BYTE_BUDGET));
+	}
+}
+
+/**
+ * @brief Deliver Message objects to the Controller objects receiving their MessageType. The 
+ * message is written into the MessagePool once, and each Controller receiving it holds a 
+ * reference.
+ * 
+ * @param view View of message to deliver
+ */
+void Taskmaster::dispatch(const MessageView* view)
+{
+	// Skip the copy if no controller receives it
+	uint8_t type = (uint8_t)view->getType();
+	if ((type >= (uint8_t)MessageType::Count) || (this->routes[type] == 0))
+		return;
+
+	messageHandle handle = g_messagePool.allocate();
+	if (handle == MESSAGE_HANDLE_NONE)
+		return; // counted by pool
+	g_messagePool.get(handle)->init(view);
+
+	this->dispatch(handle);
+
+	// Slot is freed here if no Controller received it
+	g_messagePool.release(handle);
+}
+
+/**
+ * @brief Deliver a pooled message to the Controller objects receiving its MessageType. Each 
+ * Controller receiving it adds a reference, and the caller keeps its own.
+ * 
+ * @param handle Handle of pooled message to deliver
+ */
+void Taskmaster::dispatch(messageHandle handle)
+{
+	// Look up receiving controllers
+	Message* message = g_messagePool.get(handle);
+	if (message == NULL)
+		return;
+	uint8_t type = (uint8_t)message->getType();
+	if (type >= (uint8_t)MessageType::Count)
+		return;
+	controllerMask route = this->routes[type];
+
+	for (size_t controller_idx = 0; route != 0; controller_idx++, route >>= 1)
+	{
 		// Force message to be delivered
-		controller->deliver(message, true);
+		if (route & 1)
+			controllers[controller_idx]->deliver(handle, true);
 	}
 }
 
+/**
+ * @brief Send messages waiting for each port, oldest first, while it has room
+ * 
+ */
+void Taskmaster::forward(void)
+{
+	LOOP_PORT_IDX(port_idx)
+	{
+		MessageHandleQueue<TASKMASTER_RELAY_QUEUE_SIZE>* queue = &this->relayQueues[port_idx];
+		while ((false == queue->isEmpty()) && ports[port_idx]->canSendMessage())
+		{
+			frameAddress address;
+			messageHandle handle = queue->pop(&address);
+			ports[port_idx]->sendMessage(g_messagePool.get(handle), address);
+			g_messagePool.release(handle);
+		}
+	}
+}
+
+/**
+ * @brief Send a Controller's message to the board it is for. If its port has no room, it waits 
+ * behind anything else for that port.
+ * 
+ * @param message 
+ */
+void Taskmaster::send(Message* message)
+{
+	frameAddress address = FRAME_ADDRESS(
+		taskmasterDestinationOf(message->getType()), 
+		BOARD_ADDRESS_SELF
+	);
+	uint8_t portIndex = this->getPortIndex(FRAME_ADDRESS_DESTINATION(address));
+	if (portIndex == TASKMASTER_ROUTE_SELF)
+		return; // no port toward that board
+
+	if (
+		this->relayQueues[portIndex].isEmpty() && 
+		ports[portIndex]->sendMessage(message, address)
+	)
+		return;
+
+	MessageView view;
+	message->asView(&view);
+	messageHandle handle = g_messagePool.allocate();
+	if (handle == MESSAGE_HANDLE_NONE)
+	{
+		this->numRelayDropped++;
+		return;
+	}
+	g_messagePool.get(handle)->init(&view);
+	this->relayQueues[portIndex].push(handle, address);
+}
+
 /**
  * @brief Allow Controller objects to process
  * 
@@ -66,82 +345,153 @@ void Taskmaster::process(void)
 }
 
 /**
- * @brief Check if any controllers have requested message sending priority
+ * @brief Read and send the Message objects of one priority class the Controller objects have 
+ * created to be sent. Bulk frames leave TASKMASTER_BULK_RESERVED_BYTES of the upstream transmit 
+ * buffer free, so frames relayed toward the host early next loop still find room.
  * 
+ * @param priority Class to collect
+ * @param numBytesBudget Bytes that may be collected, which may be exceeded by the last frame
+ * @return Number of bytes collected
  */
-void Taskmaster::monitorPrioritzedSenderRequests(void)
+size_t Taskmaster::collectPriority(MessagePriority priority, size_t numBytesBudget)
 {
-	// Check if current prioritzed sender should be cleared
-	if (this->prioritizedSender != nullptr)
+	size_t numBytesReserved = (priority == MessagePriority::Bulk) ? TASKMASTER_BULK_RESERVED_BYTES : 0;
+	size_t numBytesCollected = 0;
+	LOOP_CONTROLLER_IDX(controller_idx)
 	{
-		if (false == this->prioritizedSender->isRequestingPrioritizedSender())
+		ControllerGeneric* controller = controllers[controller_idx];
+
+		Message message;
+		while (
+			(numBytesCollected < numBytesBudget) &&
+			upstream->canSendMessage(numBytesReserved) &&
+			(controller->pickup(&message, priority) == ControllerMessageQueueOutput::DequeueSuccess)
+		)
 		{
-			this->prioritizedSender = nullptr;
+			this->send(&message);
+			numBytesCollected += FRAME_SIZE_FROM_RAW_SIZE(message.getRawSize());
 		}
 	}
+	return numBytesCollected;
+}
 
-	// Look for new prioritized senders
-	if (this->prioritizedSender == nullptr)
+/**
+ * @brief Let each Controller stream any Bulk frames it writes directly, within the budget and 
+ * the unreserved transmit buffer.
+ * 
+ * @param numBytesBudget Bytes that may be streamed, which may be exceeded by the last frame
+ * @return Number of bytes streamed
+ */
+size_t Taskmaster::collectStreams(size_t numBytesBudget)
+{
+	size_t numBytesStreamed = 0;
+	LOOP_CONTROLLER_IDX(controller_idx)
 	{
-		LOOP_CONTROLLER_IDX(controller_idx)
-		{
-			ControllerGeneric* controller = controllers[controller_idx];
-			if (controller->isRequestingPrioritizedSender())
-			{
-				this->prioritizedSender = controller;
-				return;
-			}
-		}
+		size_t numFreeBytes = upstream->getNumFreeTransmitBytes();
+		if (numFreeBytes <= TASKMASTER_BULK_RESERVED_BYTES) break;
+		size_t numBytesRemaining = min(
+			numBytesBudget - numBytesStreamed, 
+			numFreeBytes - TASKMASTER_BULK_RESERVED_BYTES
+		);
+		if (numBytesRemaining == 0) break;
+
+		numBytesStreamed += controllers[controller_idx]->stream(upstream->getFrameWriter(), numBytesRemaining);
+		if (numBytesStreamed >= numBytesBudget) break;
 	}
+	return numBytesStreamed;
 }
 
 /**
- * @brief Read and send all Message objects the Controller objects have created to be sent
+ * @brief Read and send the Message objects the Controller objects have created to be sent, by 
+ * strict priority: every queued Control message, then Response, then Bulk, then streamed frames. 
+ * Stops once TASKMASTER_COLLECT_BYTE_BUDGET is spent or the transmit buffer is full, leaving the 
+ * rest queued for the next loop. Nothing is dropped.
  * 
  */
 void Taskmaster::collect(void)
 {
-	LOOP_CONTROLLER_IDX(controller_idx)
+	// Everything collected passes through the port toward the host
+	if (this->upstream == NULL) return;
+
+	size_t numBytesCollected = 0;
+	for (uint8_t priority = 0; priority < (uint8_t)MessagePriority::Count; priority++)
 	{
-		ControllerGeneric* controller = controllers[controller_idx];
+		if (numBytesCollected >= TASKMASTER_COLLECT_BYTE_BUDGET) break;
+		numBytesCollected += this->collectPriority(
+			(MessagePriority)priority, 
+			TASKMASTER_COLLECT_BYTE_BUDGET - numBytesCollected
+		);
+	}
 
-		// Skip if a different controller is prioiritzed
-		if (
-			(this->prioritizedSender != nullptr) &&
-			(this->prioritizedSender != controller)
-		)
+	// Streamed frames are Bulk, and follow anything already queued
+	if (numBytesCollected < TASKMASTER_COLLECT_BYTE_BUDGET)
+		this->collectStreams(TASKMASTER_COLLECT_BYTE_BUDGET - numBytesCollected);
+}
+
+/**
+ * @brief Keep every port busy with whatever is queued for it
+ * 
+ */
+void Taskmaster::transmit(void)
+{
+	LOOP_PORT_IDX(port_idx)
+	{
+		ports[port_idx]->transmit();
+	}
+}
+
+/**
+ * @brief Find the output type pickup passed over most often, summed over every Controller. 
+ * Only pickups of a type's own MessagePriority count against it, since weights only trade types 
+ * of the same class against each other. A type held back by a busier class is not counted here.
+ * 
+ * @param outType Contains the type after call, or MessageType::Unused if none was passed over
+ * @return Number of pickups, saturating
+ */
+uint16_t Taskmaster::getMostPassedOver(MessageType* outType)
+{
+	*outType = MessageType::Unused;
+	unsigned long mostPassedOver = 0;
+	for (uint8_t type = 0; type < (uint8_t)MessageType::Count; type++)
+	{
+		unsigned long numPassedOver = 0;
+		LOOP_CONTROLLER_IDX(controller_idx)
 		{
-			continue;
+			numPassedOver += controllers[controller_idx]->getNumPassedOver((MessageType)type);
 		}
-
-		Message message;
-		while(controller->pickup(&message) != ControllerMessageQueueOutput::DequeueQueueEmpty)
+		if (numPassedOver > mostPassedOver)
 		{
-			comms->sendMessage(&message);
+			mostPassedOver = numPassedOver;
+			*outType = (MessageType)type;
 		}
 	}
+	return (mostPassedOver > UINT16_MAX) ? UINT16_MAX : (uint16_t)mostPassedOver;
 }
 
 /**
- * @brief Check if a controller is requesting send priority
+ * @brief Get the number of messages for other boards never queued for lack of a free 
+ * MessagePool slot
  * 
- * @return true 
- * @return false 
+ * @return Number of messages
  */
-bool Taskmaster::hasPrioritizedSender(void)
+unsigned long Taskmaster::getNumRelayDropped(void)
 {
-	return (this->prioritizedSender != nullptr);
+	return this->numRelayDropped;
 }
 
 /**
- * @brief Allow another party to provide a message to be dispatched by Taskmaster
- *
- * @param message
+ * @brief Get the number of messages for other boards released unsent to make room for newer ones
+ * 
+ * @return Number of messages
  */
-void Taskmaster::provideExternalMessage(Message *message)
+unsigned long Taskmaster::getNumRelayOverflowed(void)
 {
-    memoryCopy(&this->externalMessage, message, sizeof(Message));
-    this->hasExternalMessage = true;
+	unsigned long numOverflowed = 0;
+	LOOP_PORT_IDX(port_idx)
+	{
+		numOverflowed += this->relayQueues[port_idx].getNumOverflowed();
+	}
+	return numOverflowed;
 }
 
 /**
@@ -150,20 +500,13 @@ void Taskmaster::provideExternalMessage(Message *message)
  */
 void Taskmaster::execute(void)
 {
-	receive();
+	// Keep the ports busy with anything left from the last loop
+	transmit();
 
-    if (this->hasExternalMessage)
-    {
-        dispatch(&this->externalMessage);
-        this->hasExternalMessage = false;
-    }
-
-	Message message;
-	while(poll(&message))
-	{
-		dispatch(&message);
-	}
-	
+	receive();
+	forward();
 	process();
 	collect();
-}
\ No newline at end of file
+
+	transmit();
+}
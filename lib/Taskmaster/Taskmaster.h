@@ -1,57 +1,143 @@
 #pragma once
 #include <CommsInterface.h>
 #include <Controller.h>
+#include <CommsFraming.h>
+#include <MessageHandleQueue.h>
 
 /*****************************************************
  *                 COMPILER UTILITIES                *
  *****************************************************/
 #define LOOP_CONTROLLER_IDX(controllerVar)                                \
     for (size_t controller_idx = 0; controller_idx < numControllers; ++controller_idx)
+#define LOOP_PORT_IDX(portVar)                                            \
+    for (size_t port_idx = 0; port_idx < numPorts; ++port_idx)
 		
 #define CONTROLLERS_NUM_ELEMENTS(c) (size_t)(sizeof(c)/sizeof(c[0]))
-#define TASKMASTER_DECLARE(name, comms, controllers) \
-	Taskmaster name(comms, controllers, CONTROLLERS_NUM_ELEMENTS(controllers));
+#define PORTS_NUM_ELEMENTS(p) CONTROLLERS_NUM_ELEMENTS(p)
+#define TASKMASTER_NUM_CONTROLLERS_MAX (8) // one bit each in a controllerMask
 
 /**
- * @brief A Taskmaster object arbitrates between the CommsInterface and all Controller objects.
- * Every loop, the Taskmaster:
- * - Reads the CommsInterface for any Message object
- * - If a Message is received, it will disseminate it to all Controller objects receiving that 
+ * A set of a Taskmaster's controllers, one bit per index
+ */
+typedef uint8_t controllerMask;
+
+/**
+ * Declare a Taskmaster over arrays of ports and controllers, rejecting at compile time more than 
+ * it can hold
+ */
+#define TASKMASTER_DECLARE(name, ports, addressRoutes, controllers) \
+	static_assert( \
+		CONTROLLERS_NUM_ELEMENTS(controllers) <= TASKMASTER_NUM_CONTROLLERS_MAX, \
+		"Too many controllers for one Taskmaster, see TASKMASTER_NUM_CONTROLLERS_MAX" \
+	); \
+	static_assert( \
+		PORTS_NUM_ELEMENTS(ports) <= TASKMASTER_NUM_PORTS_MAX, \
+		"Too many ports for one Taskmaster, see TASKMASTER_NUM_PORTS_MAX" \
+	); \
+	Taskmaster name( \
+		ports, PORTS_NUM_ELEMENTS(ports), addressRoutes, \
+		controllers, CONTROLLERS_NUM_ELEMENTS(controllers) \
+	);
+
+/**
+ * Entry of an address route table for this board's own address, whose frames are dispatched to
+ * its controllers rather than sent on a port
+ */
+#define TASKMASTER_ROUTE_SELF (0xFF)
+
+/**
+ * @brief Get the board a controller's message is addressed to. Link negotiation stays between 
+ * neighbouring boards, and everything else reports to the host.
+ * 
+ * @param type 
+ * @return Board address
+ */
+static inline uint8_t taskmasterDestinationOf(MessageType type)
+{
+	return messageIsLinkLocal(type) ? BOARD_ADDRESS_LINK_PEER : BOARD_ADDRESS_HOST;
+}
+
+/**
+ * @brief A Taskmaster object arbitrates between every CommsInterface of the board and all 
+ * Controller objects. Each CommsInterface is a port, and a route table gives the port to send 
+ * each board address out of. Every loop, the Taskmaster:
+ * - Reads every port for frames
+ * - Disseminates each frame addressed to this board to all Controller objects receiving that 
  * type of Message
+ * - Relays each frame addressed to another board out of the port routed to it, still encoded 
+ * if nothing for that port is waiting, and also disseminates it if any Controller receives it
  * - Allow all Controller objects to process
- * - Checks for all Controllers with Message objects to send and preaches them
+ * - Checks for all Controllers with Message objects to send and preaches them, in order of 
+ * MessagePriority, addressed to the board each is for
  * 
- * @tparam numControllers 
  */
 class Taskmaster 
 {
 private:
-	CommsInterface* comms;
+	CommsInterface** ports;
+	size_t numPorts;
+
+	/**
+	 * @brief For each board address, the index of the port toward it, or TASKMASTER_ROUTE_SELF. 
+	 * BOARD_ADDRESS_COUNT entries.
+	 * 
+	 */
+	const uint8_t* addressRoutes;
+
+	/**
+	 * @brief Port toward the host, which controllers' messages and streams are collected for
+	 * 
+	 */
+	CommsInterface* upstream;
+
 	ControllerGeneric** controllers;
 	size_t numControllers;
 
 	/**
-	 * @brief A controller can request for its messages to be prioiritzed
+	 * @brief For each MessageType, the controllers receiving it. Built from each controller's 
+	 * compile-time subscriptions, so dispatch touches only interested controllers.
 	 * 
 	 */
-	ControllerGeneric* prioritizedSender;
+	controllerMask routes[(uint8_t)MessageType::Count];
 
 	/**
-	 * @brief An external module can pass in a message to be dispatched, such as from the echo
+	 * @brief For each port, messages for other boards waiting for room, each tagged with its 
+	 * frame address
 	 * 
 	 */
-	bool hasExternalMessage;
-	Message externalMessage;
+	MessageHandleQueue<TASKMASTER_RELAY_QUEUE_SIZE> relayQueues[TASKMASTER_NUM_PORTS_MAX];
+
+	/**
+	 * Messages for other boards never queued for lack of a free MessagePool slot
+	 */
+	unsigned long numRelayDropped;
 
+	void route(void);
+	uint8_t getPortIndex(uint8_t address);
+	bool isRelaySuppressed(MessageType type, uint8_t destination);
+	void hold(uint8_t portIndex, const MessageView* view, frameAddress address);
+	void relayFrame(CommsInterface* from, const char* frame, size_t frameSize, frameAddress address);
+	void routeFrame(CommsInterface* from, const char* frame, size_t frameSize);
 	void receive(void);
-	bool poll(Message* message);
-	void dispatch(Message* message);
+	void dispatch(const MessageView* view);
+	void dispatch(messageHandle handle);
+	void forward(void);
+	void send(Message* message);
 	void process(void);
-	void monitorPrioritzedSenderRequests(void);
+	size_t collectPriority(MessagePriority priority, size_t numBytesBudget);
+	size_t collectStreams(size_t numBytesBudget);
 	void collect(void);
+	void transmit(void);
 public:
-	Taskmaster(CommsInterface* comms, ControllerGeneric* controllers[], size_t numControllers);
-	bool hasPrioritizedSender(void);
-	void provideExternalMessage(Message* message);
+	Taskmaster(
+		CommsInterface* ports[], 
+		size_t numPorts, 
+		const uint8_t addressRoutes[], 
+		ControllerGeneric* controllers[], 
+		size_t numControllers
+	);
+	uint16_t getMostPassedOver(MessageType* outType);
+	unsigned long getNumRelayDropped(void);
+	unsigned long getNumRelayOverflowed(void);
 	void execute(void);
-};
+};
\ No newline at end of file
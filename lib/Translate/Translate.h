@@ -1,37 +1,12 @@
 #pragma once
 #include "Message.h"
-#include "TranslateDrivetrain.h"
-#include "TranslateSensors.h"
-#include "TranslateGripper.h"
 
 /**
- * @brief Instantiate all EnumMessageMap objects for translation
+ * @brief Declare every EnumStringMap, struct field list and translator, generated from 
+ * schema/messages.json by scripts/generate_messages.py
  * 
- * Each call to ENUM_MESSAGE_MAP_TRANSLATION(enumType) creates enumTypeTranslation
+ * Each xxxTranslation is declared extern here and defined once in TranslateSchema.cpp. Structs 
+ * stay hand-written in their Defs headers, and MUST be marked as __attribute__((packed)). The 
+ * generated header checks the size of each of their fields against the schema.
  */
-ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainManualCommand)
-ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainManualResponse)
-ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainAutomatedResponse)
-ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainEncoderState)
-#if defined(BOARD_CONTROLLER)
-ENUM_MESSAGE_MAP_TRANSLATION(LidarState)
-ENUM_MESSAGE_MAP_TRANSLATION(UltrasonicState)
-ENUM_MESSAGE_MAP_TRANSLATION(GripperCommand)
-ENUM_MESSAGE_MAP_TRANSLATION(GripperState)
-#endif
-
-/**
- * @brief Instantiate all StructMessageMap objects for translation
- * 
- * Each call to STRUCT_MESSAGE_MAP_TRANSLATION(structType) creates structTypeTranslation.
- * 
- * All structs MUST be marked as __attribute__((packed))
- */
-STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainEncoderDistances)
-STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainAutomatedCommand)
-STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainDisplacements)
-STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainMotorCommand)
-#if defined(BOARD_CONTROLLER)
-STRUCT_MESSAGE_MAP_TRANSLATION(LidarPointReading)
-STRUCT_MESSAGE_MAP_TRANSLATION(UltrasonicPointReading)
-#endif
\ No newline at end of file
+#include "TranslateSchema.h"
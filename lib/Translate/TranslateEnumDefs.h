@@ -1,32 +1,75 @@
 #pragma once
 #include "Types.h"
 #include <Message.h>
+#include <CommsFrameWriter.h>
 
 /*****************************************************
  *                 COMPILER UTILITIES                *
  *****************************************************/
 #define ENUM_MAP_ENTRY(e, s) { static_cast<uint8_t>(e), s }
 #define MAP_NUM_ELEMENTS(m) (size_t)(sizeof(m)/sizeof(m[0]))
+
+/**
+ * An enum is sent as a single code char, its value. Codes are below the first printable char, so 
+ * a code is never mistaken for a legacy string representation, which is still accepted.
+ */
+#define ENUM_CODE_LENGTH (1)
+#define ENUM_CODE_LIMIT (0x20)
+
 /* Though not strictly enforced, all string literal representations in map should not be longer 
-than MESSAGE_CONTENT_LENGTH_MAX */
+than MESSAGE_CONTENT_LENGTH_MAX. Entries must be in enum order, so both are indexed by value. */
 #define COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(map, enum) \
 	static_assert( \
 		(sizeof(map)/sizeof(map[0])) == (uint8_t)(enum::Count), \
 		#map " entries are not correctly mapped to all enums in " #enum \
+	); \
+	static_assert( \
+		isEnumMapInOrder(map), \
+		#map " entries are not in the order of " #enum \
+	); \
+	static_assert( \
+		(uint8_t)(enum::Count) <= ENUM_CODE_LIMIT, \
+		#enum " has too many values to be sent as a code" \
 	);
 
-#define ENUM_MESSAGE_MAP_TRANSLATION(e) static EnumMessageMap<e, MAP_NUM_ELEMENTS(e##Map)> \
+/* Declared in every translation unit including Translate.h, and defined once in TranslateSchema.cpp */
+#define ENUM_MESSAGE_MAP_TRANSLATION(e) extern EnumMessageMap<e, MAP_NUM_ELEMENTS(e##Map)> \
+	e##Translation;
+#define ENUM_MESSAGE_MAP_DEFINITION(e) EnumMessageMap<e, MAP_NUM_ELEMENTS(e##Map)> \
 	e##Translation(MessageType::e, e##Map);
 
+/**
+ * Longest string representation of an enum, including null-terminator. A longer string literal 
+ * in an EnumStringMap fails to compile.
+ */
+#define ENUM_STRING_LENGTH_MAX (13)
+
 /**
  * Define an EnumStringMap to decode a string into an appropriate enum, given the type of 
- * MessageType.
+ * MessageType. Each map is declared PROGMEM, with its strings held in each entry, so neither 
+ * is copied into SRAM at startup. Entries are read with the pgm_read and _P functions.
  */
 struct EnumStringMap {
 	uint8_t enumValue;
-	const char* strRep;
+	char strRep[ENUM_STRING_LENGTH_MAX];
 };
 
+/**
+ * @brief Check that every entry of an EnumStringMap is at the index of its enum value
+ * 
+ * @param map 
+ * @param index Entry to check from
+ * @return Whether the map is in enum order
+ */
+template <size_t numElements>
+constexpr bool isEnumMapInOrder(const EnumStringMap (&map)[numElements], size_t index = 0)
+{
+	return (index >= numElements) || (
+		(map[index].enumValue == index) && 
+		isEnumMapInOrder(map, index + 1)
+	);
+}
+
 /* 
  * Define an EnumMessageMap to connect an EnumStringMap to a given MessageType.
  *
@@ -39,56 +82,108 @@ private:
 	const EnumStringMap (&enumStringMap)[numElements];
 
 	/**
-	 * @brief Given a generic enum, get the string literal representation.
+	 * @brief Given a generic enum, copy the string literal representation out of flash. The map 
+	 * is in enum order, so it is indexed by value.
 	 * 
 	 * @param e An enum
-	 * @return constexpr const char* String literal representation
+	 * @param outBuffer Contains string literal representation after call, must be of minimum 
+	 * size ENUM_STRING_LENGTH_MAX
 	 */
-	const char* enumToStr(E e) const {
-		for (size_t i = 0; i < numElements; ++i)
-			if (enumStringMap[i].enumValue == static_cast<uint8_t>(e))
-				return enumStringMap[i].strRep;
-		return "";
+	void enumToStr(E e, char* outBuffer) const {
+		uint8_t value = static_cast<uint8_t>(e);
+		outBuffer[0] = '\0';
+		if (value < numElements)
+			strncpy_P(outBuffer, enumStringMap[value].strRep, ENUM_STRING_LENGTH_MAX);
     }
 
 	/**
-	 * @brief Given a string, get the generic enum representation.
+	 * @brief Given message content, get the generic enum representation. A single code char is 
+	 * the enum value. Anything else is a legacy string representation, which is searched for.
 	 * 
-	 * @param buffer A string
+	 * @param content Null-terminated content
+	 * @param size Number of content bytes
 	 * @return constexpr E Generic enum representation
 	 */
-	const E strToEnum(const char* buffer) const {
-    	if (!buffer || buffer[0] == '\0') return E::NoReceived;
+	const E contentToEnum(const char* content, size_t size) const {
+		if (!content || size == 0) return E::NoReceived;
+		uint8_t code = (uint8_t)content[0];
+		if ((size == ENUM_CODE_LENGTH) && (code < ENUM_CODE_LIMIT))
+			return (code < numElements) ? static_cast<E>(code) : E::Invalid;
+		if (content[0] == '\0') return E::NoReceived;
         for (size_t i = 0; i < numElements; ++i)
-            if (stringsEqual(enumStringMap[i].strRep, buffer))
-                return static_cast<E>(enumStringMap[i].enumValue);
+            if (strcmp_P(content, enumStringMap[i].strRep) == 0)
+                return static_cast<E>(pgm_read_byte(&enumStringMap[i].enumValue));
         return E::Invalid;
     }
 
 public:
-	EnumMessageMap(MessageType type, const EnumStringMap (&map)[numElements]) : type(type), enumStringMap(map) {};
+	constexpr EnumMessageMap(MessageType type, const EnumStringMap (&map)[numElements]) : 
+		type(type), enumStringMap(map) {};
 
 	/**
-	 * @brief Provided an enum, initialize and output a corresponding message.
+	 * @brief Provided an enum, initialize and output a corresponding message. The content is 
+	 * its code char, or its string representation if ENUM_WILL_SEND_CODES is false.
 	 * 
 	 * @param e An enum to translate
 	 * @param outMessage Message with appropriate type and content, now initialized
 	 */
 	void asMessage(const E e, Message* outMessage)
 	{
-		outMessage->init(type, MESSAGE_CONTENT_SIZE_AUTOMATIC, enumToStr(e));
+		if (ENUM_WILL_SEND_CODES)
+		{
+			const char code = (char)static_cast<uint8_t>(e);
+			outMessage->init(type, ENUM_CODE_LENGTH, &code);
+			return;
+		}
+		char str[ENUM_STRING_LENGTH_MAX];
+		enumToStr(e, str);
+		outMessage->init(type, MESSAGE_CONTENT_SIZE_AUTOMATIC, str);
 	}
 
 	/**
-	 * @brief Provided a message, return a corresponding enum.
+	 * @brief Provided an enum, encode a corresponding frame straight into the transmit buffer.
+	 * 
+	 * @param e An enum to translate
+	 * @param writer Writer of the transmit buffer
+	 * @return Number of bytes in frame, or 0 if the transmit buffer lacked space
+	 */
+	size_t asFrame(const E e, FrameWriter* writer)
+	{
+		char content[ENUM_STRING_LENGTH_MAX];
+		if (ENUM_WILL_SEND_CODES)
+			content[0] = (char)static_cast<uint8_t>(e);
+		else
+			enumToStr(e, content);
+		size_t size = ENUM_WILL_SEND_CODES ? 
+			ENUM_CODE_LENGTH : 
+			stringLength(content, MESSAGE_CONTENT_LENGTH_MAX);
+		if (false == writer->begin(type, size)) return 0;
+		writer->write(content, size);
+		return writer->end();
+	}
+
+	/**
+	 * @brief Provided a message, return a corresponding enum. The content is read in place.
 	 * 
 	 * @param message A message to translate
 	 * @return E An appropriate enum
 	 */
 	E asEnum(Message* message)
 	{
-		char buffer[MESSAGE_CONTENT_LENGTH_MAX];
-		message->getContent(buffer);
-		return strToEnum(buffer);
+		MessageView view;
+		message->asView(&view);
+		return asEnum(&view);
+	}
+
+	/**
+	 * @brief Provided a view of a message, return a corresponding enum. The content is read in 
+	 * place.
+	 * 
+	 * @param view A view of a message to translate
+	 * @return E An appropriate enum
+	 */
+	E asEnum(const MessageView* view)
+	{
+		return contentToEnum(view->getContent(), view->getContentSize());
 	}
 };
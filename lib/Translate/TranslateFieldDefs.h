@@ -0,0 +1,181 @@
+#pragma once
+#include "Types.h"
+#include <MemoryUtilities.h>
+
+/*****************************************************
+ *                   SCALAR CODING                   *
+ *****************************************************/
+
+/**
+ * @brief Unsigned integer holding the raw bits of a scalar of a given size
+ */
+template <size_t size> struct WireRaw;
+template <> struct WireRaw<1> { typedef uint8_t type; };
+template <> struct WireRaw<2> { typedef uint16_t type; };
+template <> struct WireRaw<4> { typedef uint32_t type; };
+
+/**
+ * @brief Unrolled little-endian copy of the low numBytes bytes of a raw value
+ *
+ * @tparam numBytes Bytes left to copy
+ */
+template <uint8_t numBytes>
+struct WireBytes
+{
+	template <typename R>
+	static void put(R raw, uint8_t* out)
+	{
+		out[numBytes - 1] = (uint8_t)(raw >> (8 * (numBytes - 1)));
+		WireBytes<numBytes - 1>::put(raw, out);
+	}
+
+	template <typename R>
+	static R get(const uint8_t* in)
+	{
+		return (R)(((R)in[numBytes - 1]) << (8 * (numBytes - 1))) | WireBytes<numBytes - 1>::template get<R>(in);
+	}
+};
+template <>
+struct WireBytes<0>
+{
+	template <typename R> static void put(R, uint8_t*) {}
+	template <typename R> static R get(const uint8_t*) { return 0; }
+};
+
+/**
+ * @brief Encode and decode a value as it is sent, little-endian whatever the board. Scalars
+ * (integers, floats, bools and enums) are coded by this primary template. Structs are coded by
+ * the specialization that STRUCT_MESSAGE_MAP_FIELDS declares for them.
+ *
+ * @tparam T Type of value
+ */
+template <typename T>
+struct WireCodec
+{
+	typedef typename WireRaw<sizeof(T)>::type raw_t; // undefined for structs without fields
+
+	static constexpr size_t size = sizeof(T);
+
+	static void encode(const T value, uint8_t* out)
+	{
+		raw_t raw;
+		memoryCopy(&raw, &value, sizeof(T)); // Interpret value as raw bytes
+		WireBytes<sizeof(T)>::put(raw, out);
+	}
+
+	static T decode(const uint8_t* in)
+	{
+		raw_t raw = WireBytes<sizeof(T)>::template get<raw_t>(in);
+		T value;
+		memoryCopy(&value, &raw, sizeof(T)); // Interpret raw bytes as a T
+		return value;
+	}
+};
+
+/*****************************************************
+ *                  FIELD DESCRIPTORS                *
+ *****************************************************/
+
+/**
+ * @brief Describe one field of a struct, coded by the WireCodec of its type.
+ *
+ * @tparam S Type of struct
+ * @tparam T Type of field
+ * @tparam member Pointer to field
+ */
+template <typename S, typename T, T S::*member>
+struct StructField
+{
+	static constexpr size_t size = WireCodec<T>::size;
+
+	static void encode(const S& s, uint8_t* out) { WireCodec<T>::encode(s.*member, out); }
+	static void decode(S* s, const uint8_t* in) { s->*member = WireCodec<T>::decode(in); }
+};
+
+/**
+ * @brief Describe one array field of a struct, coded element by element.
+ */
+template <typename S, typename T, size_t length, T (S::*member)[length]>
+struct StructField<S, T[length], member>
+{
+	static constexpr size_t size = length * WireCodec<T>::size;
+
+	static void encode(const S& s, uint8_t* out)
+	{
+		for (size_t i = 0; i < length; i++)
+			WireCodec<T>::encode((s.*member)[i], out + i * WireCodec<T>::size);
+	}
+	static void decode(S* s, const uint8_t* in)
+	{
+		for (size_t i = 0; i < length; i++)
+			(s->*member)[i] = WireCodec<T>::decode(in + i * WireCodec<T>::size);
+	}
+};
+
+/**
+ * @brief Code every field of a struct back to back, in the order listed. Offsets are known at
+ * compile time, so each call unrolls to one copy per field.
+ *
+ * @tparam S Type of struct
+ * @tparam Fields StructField of each field, in declaration order
+ */
+template <typename S, typename... Fields>
+struct StructFieldList;
+template <typename S>
+struct StructFieldList<S>
+{
+	static constexpr size_t size = 0;
+
+	static void encode(const S&, uint8_t*) {}
+	static void decodeInto(S*, const uint8_t*) {}
+};
+template <typename S, typename Field, typename... Fields>
+struct StructFieldList<S, Field, Fields...>
+{
+	static constexpr size_t size = Field::size + StructFieldList<S, Fields...>::size;
+
+	static void encode(const S& s, uint8_t* out)
+	{
+		Field::encode(s, out);
+		StructFieldList<S, Fields...>::encode(s, out + Field::size);
+	}
+
+	static void decodeInto(S* s, const uint8_t* in)
+	{
+		Field::decode(s, in);
+		StructFieldList<S, Fields...>::decodeInto(s, in + Field::size);
+	}
+
+	/**
+	 * @brief Decode a struct by value, as a field of another struct
+	 */
+	static S decode(const uint8_t* in)
+	{
+		S s;
+		decodeInto(&s, in);
+		return s;
+	}
+};
+
+/*****************************************************
+ *                 COMPILER UTILITIES                *
+ *****************************************************/
+#define STRUCT_FIELD(s, f) StructField<s, decltype(s::f), &s::f>
+
+/* Apply STRUCT_FIELD to each of up to 8 fields */
+#define STRUCT_FIELDS_EXPAND(x) x
+#define STRUCT_FIELDS_CONCAT_(a, b) a##b
+#define STRUCT_FIELDS_CONCAT(a, b) STRUCT_FIELDS_CONCAT_(a, b)
+#define STRUCT_FIELDS_COUNT(...) \
+    STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_NTH(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define STRUCT_FIELDS_NTH(_1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define STRUCT_FIELDS_1(s, f) STRUCT_FIELD(s, f)
+#define STRUCT_FIELDS_2(s, f, ...) STRUCT_FIELD(s, f), STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_1(s, __VA_ARGS__))
+#define STRUCT_FIELDS_3(s, f, ...) STRUCT_FIELD(s, f), STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_2(s, __VA_ARGS__))
+#define STRUCT_FIELDS_4(s, f, ...) STRUCT_FIELD(s, f), STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_3(s, __VA_ARGS__))
+#define STRUCT_FIELDS_5(s, f, ...) STRUCT_FIELD(s, f), STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_4(s, __VA_ARGS__))
+#define STRUCT_FIELDS_6(s, f, ...) STRUCT_FIELD(s, f), STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_5(s, __VA_ARGS__))
+#define STRUCT_FIELDS_7(s, f, ...) STRUCT_FIELD(s, f), STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_6(s, __VA_ARGS__))
+#define STRUCT_FIELDS_8(s, f, ...) STRUCT_FIELD(s, f), STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_7(s, __VA_ARGS__))
+#define STRUCT_FIELD_LIST(s, ...) \
+    STRUCT_FIELDS_EXPAND(STRUCT_FIELDS_CONCAT(STRUCT_FIELDS_, STRUCT_FIELDS_COUNT(__VA_ARGS__))(s, __VA_ARGS__))
@@ -0,0 +1,32 @@
+/* Generated by scripts/generate_messages.py from schema/messages.json. Do not edit. */
+#include <Translate.h>
+
+/*****************************************************
+ *                     INSTANCES                     *
+ *****************************************************/
+
+ENUM_MESSAGE_MAP_DEFINITION(DrivetrainManualCommand)
+ENUM_MESSAGE_MAP_DEFINITION(DrivetrainManualResponse)
+STRUCT_MESSAGE_MAP_DEFINITION(DrivetrainAutomatedCommand)
+ENUM_MESSAGE_MAP_DEFINITION(DrivetrainAutomatedResponse)
+ENUM_MESSAGE_MAP_DEFINITION(DrivetrainEncoderState)
+STRUCT_MESSAGE_MAP_DEFINITION(DrivetrainEncoderDistances)
+STRUCT_MESSAGE_MAP_DEFINITION(DrivetrainDisplacements)
+STRUCT_MESSAGE_MAP_DEFINITION(DrivetrainMotorCommand)
+STRUCT_MESSAGE_MAP_DEFINITION(DrivetrainEncoderTicks)
+STRUCT_MESSAGE_MAP_DEFINITION(DrivetrainDisplacementsFixed)
+STRUCT_MESSAGE_MAP_DEFINITION(DrivetrainMotorCommandFixed)
+STRUCT_MESSAGE_MAP_DEFINITION(LinkControl)
+STRUCT_MESSAGE_MAP_DEFINITION(DiagnosticsCounters)
+#if defined(BOARD_CONTROLLER)
+ENUM_MESSAGE_MAP_DEFINITION(LidarState)
+STRUCT_MESSAGE_MAP_DEFINITION(LidarPointReading)
+STRUCT_MESSAGE_MAP_DEFINITION(LidarScanChunk)
+STRUCT_MESSAGE_MAP_DEFINITION(LidarScanChunkCompact)
+ENUM_MESSAGE_MAP_DEFINITION(UltrasonicState)
+STRUCT_MESSAGE_MAP_DEFINITION(UltrasonicPointReading)
+ENUM_MESSAGE_MAP_DEFINITION(GripperCommand)
+ENUM_MESSAGE_MAP_DEFINITION(GripperState)
+STRUCT_MESSAGE_MAP_DEFINITION(LoopTimeHistogram)
+STRUCT_MESSAGE_MAP_DEFINITION(EchoFilter)
+#endif
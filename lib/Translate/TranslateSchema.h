@@ -0,0 +1,212 @@
+#pragma once
+/* Generated by scripts/generate_messages.py from schema/messages.json. Do not edit. */
+#include <MessageType.h>
+#include <DrivetrainDefs.h>
+#include <LinkDefs.h>
+#include <DiagnosticsDefs.h>
+#if defined(BOARD_CONTROLLER)
+#include <LidarDefs.h>
+#include <UltrasonicDefs.h>
+#include <CommsEchoDefs.h>
+#endif
+#include "TranslateEnumDefs.h"
+#include "TranslateStructDefs.h"
+
+/*****************************************************
+ *                   ENUM MAPPING                    *
+ *****************************************************/
+
+static constexpr EnumStringMap DrivetrainManualCommandMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::Invalid,            "invalid"),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::NoReceived,         ""),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::TranslateForward,   "w"),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::TranslateBackward,  "s"),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::RotateLeft,         "a"),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::RotateRight,        "d"),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::Brake,              "z"),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::Halt,               "h"),
+    ENUM_MAP_ENTRY(DrivetrainManualCommand::Automated,          "auto"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(DrivetrainManualCommandMap, DrivetrainManualCommand);
+
+static constexpr EnumStringMap DrivetrainManualResponseMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(DrivetrainManualResponse::Invalid,        "invalid"),
+    ENUM_MAP_ENTRY(DrivetrainManualResponse::NoReceived,     ""),
+    ENUM_MAP_ENTRY(DrivetrainManualResponse::Acknowledge,    "ackval"),
+    ENUM_MAP_ENTRY(DrivetrainManualResponse::NotifyHalting,  "notifhalt"),
+    ENUM_MAP_ENTRY(DrivetrainManualResponse::NotifyBraking,  "notifbrake"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(DrivetrainManualResponseMap, DrivetrainManualResponse);
+
+static constexpr EnumStringMap DrivetrainAutomatedResponseMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(DrivetrainAutomatedResponse::Invalid,      "invalid"),
+    ENUM_MAP_ENTRY(DrivetrainAutomatedResponse::NoReceived,   ""),
+    ENUM_MAP_ENTRY(DrivetrainAutomatedResponse::Acknowledge,  "ack"),
+    ENUM_MAP_ENTRY(DrivetrainAutomatedResponse::InProgress,   "inprog"),
+    ENUM_MAP_ENTRY(DrivetrainAutomatedResponse::Overshot,     "overshot"),
+    ENUM_MAP_ENTRY(DrivetrainAutomatedResponse::AtTarget,     "attarget"),
+    ENUM_MAP_ENTRY(DrivetrainAutomatedResponse::Aborted,      "abort"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(DrivetrainAutomatedResponseMap, DrivetrainAutomatedResponse);
+
+static constexpr EnumStringMap DrivetrainEncoderStateMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(DrivetrainEncoderState::Invalid,     "invalid"),
+    ENUM_MAP_ENTRY(DrivetrainEncoderState::NoReceived,  ""),
+    ENUM_MAP_ENTRY(DrivetrainEncoderState::Request,     "e"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(DrivetrainEncoderStateMap, DrivetrainEncoderState);
+
+#if defined(BOARD_CONTROLLER)
+static constexpr EnumStringMap LidarStateMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(LidarState::Invalid,          "invalid"),
+    ENUM_MAP_ENTRY(LidarState::NoReceived,       ""),
+    ENUM_MAP_ENTRY(LidarState::Request,          "l"),
+    ENUM_MAP_ENTRY(LidarState::RequestKeyframe,  "lk"),
+    ENUM_MAP_ENTRY(LidarState::Rejected,         "reject"),
+    ENUM_MAP_ENTRY(LidarState::NotOpen,          "notopen"),
+    ENUM_MAP_ENTRY(LidarState::CannotScan,       "cannotscan"),
+    ENUM_MAP_ENTRY(LidarState::HealthUnknown,    "cannotverify"),
+    ENUM_MAP_ENTRY(LidarState::NotHealthy,       "unhealthy"),
+    ENUM_MAP_ENTRY(LidarState::Success,          "success"),
+    ENUM_MAP_ENTRY(LidarState::Complete,         "complete"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(LidarStateMap, LidarState);
+
+static constexpr EnumStringMap UltrasonicStateMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(UltrasonicState::Invalid,     "invalid"),
+    ENUM_MAP_ENTRY(UltrasonicState::NoReceived,  ""),
+    ENUM_MAP_ENTRY(UltrasonicState::Request,     "p"),
+    ENUM_MAP_ENTRY(UltrasonicState::Rejected,    "rejected"),
+    ENUM_MAP_ENTRY(UltrasonicState::InProgress,  "inprog"),
+    ENUM_MAP_ENTRY(UltrasonicState::Success,     "success"),
+    ENUM_MAP_ENTRY(UltrasonicState::Complete,    "complete"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(UltrasonicStateMap, UltrasonicState);
+
+static constexpr EnumStringMap GripperCommandMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(GripperCommand::Invalid,     "invalid"),
+    ENUM_MAP_ENTRY(GripperCommand::NoReceived,  ""),
+    ENUM_MAP_ENTRY(GripperCommand::Home,        "home"),
+    ENUM_MAP_ENTRY(GripperCommand::Extend,      "extend"),
+    ENUM_MAP_ENTRY(GripperCommand::Ready,       "ready"),
+    ENUM_MAP_ENTRY(GripperCommand::Open,        "open"),
+    ENUM_MAP_ENTRY(GripperCommand::Close,       "close"),
+    ENUM_MAP_ENTRY(GripperCommand::Ping,        "ping"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(GripperCommandMap, GripperCommand);
+
+static constexpr EnumStringMap GripperStateMap[] PROGMEM = {
+    ENUM_MAP_ENTRY(GripperState::Invalid,         "invalid"),
+    ENUM_MAP_ENTRY(GripperState::NoReceived,      ""),
+    ENUM_MAP_ENTRY(GripperState::Home,            "home"),
+    ENUM_MAP_ENTRY(GripperState::ReadyClosed,     "ready_c"),
+    ENUM_MAP_ENTRY(GripperState::ReadyOpened,     "ready_o"),
+    ENUM_MAP_ENTRY(GripperState::ExtendedClosed,  "ext_c"),
+    ENUM_MAP_ENTRY(GripperState::ExtendedOpened,  "ext_o"),
+};
+COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT(GripperStateMap, GripperState);
+
+#endif
+
+/*****************************************************
+ *                  STRUCT MAPPING                   *
+ *****************************************************/
+
+STRUCT_MESSAGE_MAP_FIELDS(DrivetrainAutomatedCommand, dX_in, dY_in, dTheta_deg);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainAutomatedCommand, dX_in, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainAutomatedCommand, dY_in, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainAutomatedCommand, dTheta_deg, 2);
+STRUCT_MESSAGE_MAP_FIELDS(DrivetrainEncoderDistances, encoder1Dist, encoder2Dist, encoder3Dist);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainEncoderDistances, encoder1Dist, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainEncoderDistances, encoder2Dist, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainEncoderDistances, encoder3Dist, 4);
+STRUCT_MESSAGE_MAP_FIELDS(DrivetrainDisplacements, dX_in, dY_in, dTheta_rad);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainDisplacements, dX_in, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainDisplacements, dY_in, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainDisplacements, dTheta_rad, 4);
+STRUCT_MESSAGE_MAP_FIELDS(DrivetrainMotorCommand, is1Forward, speed1, is2Forward, speed2, is3Forward, speed3);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommand, is1Forward, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommand, speed1, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommand, is2Forward, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommand, speed2, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommand, is3Forward, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommand, speed3, 4);
+STRUCT_MESSAGE_MAP_FIELDS(DrivetrainEncoderTicks, encoder1Ticks, encoder2Ticks, encoder3Ticks);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainEncoderTicks, encoder1Ticks, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainEncoderTicks, encoder2Ticks, 4);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainEncoderTicks, encoder3Ticks, 4);
+STRUCT_MESSAGE_MAP_FIELDS(DrivetrainDisplacementsFixed, dX_centiIn, dY_centiIn, dTheta_centiRad);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainDisplacementsFixed, dX_centiIn, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainDisplacementsFixed, dY_centiIn, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainDisplacementsFixed, dTheta_centiRad, 2);
+STRUCT_MESSAGE_MAP_FIELDS(DrivetrainMotorCommandFixed, forwardBits, speed1, speed2, speed3);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommandFixed, forwardBits, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommandFixed, speed1, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommandFixed, speed2, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DrivetrainMotorCommandFixed, speed3, 1);
+STRUCT_MESSAGE_MAP_FIELDS(LinkControl, operation, rateIndex, pattern);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LinkControl, operation, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LinkControl, rateIndex, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LinkControl, pattern, 8);
+STRUCT_MESSAGE_MAP_FIELDS(DiagnosticsCounters, mostPassedOverType, numPassedOver, numRelayDropped, numRelayOverflowed);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DiagnosticsCounters, mostPassedOverType, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DiagnosticsCounters, numPassedOver, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DiagnosticsCounters, numRelayDropped, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(DiagnosticsCounters, numRelayOverflowed, 2);
+#if defined(BOARD_CONTROLLER)
+STRUCT_MESSAGE_MAP_FIELDS(LidarPointReading, angle, distance);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarPointReading, angle, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarPointReading, distance, 2);
+STRUCT_MESSAGE_MAP_FIELDS(LidarScanChunk, startIndex, numPoints, distance);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarScanChunk, startIndex, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarScanChunk, numPoints, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarScanChunk, distance[0], 2);
+STRUCT_MESSAGE_MAP_FIELDS(LidarScanChunkCompact, startIndex, numPoints, encoded);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarScanChunkCompact, startIndex, 2);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarScanChunkCompact, numPoints, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LidarScanChunkCompact, encoded[0], 1);
+STRUCT_MESSAGE_MAP_FIELDS(UltrasonicPointReading, whichUltrasonic, encoders, distance);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(UltrasonicPointReading, whichUltrasonic, 1);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(UltrasonicPointReading, encoders, 12);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(UltrasonicPointReading, distance, 4);
+STRUCT_MESSAGE_MAP_FIELDS(LoopTimeHistogram, count, maxLoopTime_us);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LoopTimeHistogram, count, 24);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(LoopTimeHistogram, maxLoopTime_us, 4);
+STRUCT_MESSAGE_MAP_FIELDS(EchoFilter, suppressedTypes);
+COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(EchoFilter, suppressedTypes, 4);
+#endif
+
+/*****************************************************
+ *                   TRANSLATIONS                    *
+ *****************************************************/
+
+/**
+ * @brief Declare all EnumMessageMap and StructMessageMap objects for translation, each defined 
+ * once in TranslateSchema.cpp
+ * 
+ */
+ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainManualCommand)
+ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainManualResponse)
+ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainAutomatedResponse)
+ENUM_MESSAGE_MAP_TRANSLATION(DrivetrainEncoderState)
+STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainAutomatedCommand)
+STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainEncoderDistances)
+STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainDisplacements)
+STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainMotorCommand)
+STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainEncoderTicks)
+STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainDisplacementsFixed)
+STRUCT_MESSAGE_MAP_TRANSLATION(DrivetrainMotorCommandFixed)
+STRUCT_MESSAGE_MAP_TRANSLATION(LinkControl)
+STRUCT_MESSAGE_MAP_TRANSLATION(DiagnosticsCounters)
+#if defined(BOARD_CONTROLLER)
+ENUM_MESSAGE_MAP_TRANSLATION(LidarState)
+ENUM_MESSAGE_MAP_TRANSLATION(UltrasonicState)
+ENUM_MESSAGE_MAP_TRANSLATION(GripperCommand)
+ENUM_MESSAGE_MAP_TRANSLATION(GripperState)
+STRUCT_MESSAGE_MAP_TRANSLATION(LidarPointReading)
+STRUCT_MESSAGE_MAP_TRANSLATION(LidarScanChunk)
+STRUCT_MESSAGE_MAP_TRANSLATION(LidarScanChunkCompact)
+STRUCT_MESSAGE_MAP_TRANSLATION(UltrasonicPointReading)
+STRUCT_MESSAGE_MAP_TRANSLATION(LoopTimeHistogram)
+STRUCT_MESSAGE_MAP_TRANSLATION(EchoFilter)
+#endif
@@ -1,6 +1,8 @@
 #pragma once
 #include "Types.h"
 #include <Message.h>
+#include <CommsFrameWriter.h>
+#include "TranslateFieldDefs.h"
 
 /*****************************************************
  *                 COMPILER UTILITIES                *
@@ -11,11 +13,30 @@
         #struct " size exceeds MESSAGE_CONTENT_LENGTH_MAX" \
     )
 
-#define STRUCT_MESSAGE_MAP_TRANSLATION(s) \
-    static StructMessageMap<s> s##Translation(MessageType::s); \
-    /* Declare the unique deserialization function */ \
+#define COMPILE_TIME_ENFORCE_STRUCT_FIELDS(struct) \
+    static_assert( \
+        WireCodec<struct>::size == sizeof(struct), \
+        #struct " fields do not cover every byte of the struct" \
+    )
+
+#define COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE(struct, field, size) \
+    static_assert( \
+        sizeof(struct::field) == (size), \
+        #struct "::" #field " size does not match schema/messages.json" \
+    )
+
+/* List every field of a struct in declaration order, to generate its encoder and decoder */
+#define STRUCT_MESSAGE_MAP_FIELDS(s, ...) \
     template<> \
-    void StructMessageMap<s>::strToStruct(s*, const char*) const;
+    struct WireCodec<s> : StructFieldList<s, STRUCT_FIELD_LIST(s, __VA_ARGS__)> {}; \
+    COMPILE_TIME_ENFORCE_STRUCT_SIZE(s); \
+    COMPILE_TIME_ENFORCE_STRUCT_FIELDS(s)
+
+/* Declared in every translation unit including Translate.h, and defined once in TranslateSchema.cpp */
+#define STRUCT_MESSAGE_MAP_TRANSLATION(s) \
+    extern StructMessageMap<s> s##Translation;
+#define STRUCT_MESSAGE_MAP_DEFINITION(s) \
+    StructMessageMap<s> s##Translation(MessageType::s);
 
 /* 
  * Define a StructMessageMap to connect an struct to a given MessageType.
@@ -29,16 +50,17 @@ private:
 	size_t size;
 
 public:
-	StructMessageMap(MessageType type) : type(type), size(sizeof(S)) {};
+	constexpr StructMessageMap(MessageType type) : type(type), size(sizeof(S)) {};
 
 	/**
-	 * @brief Given a generic value, get the char reprsentation (i.e. as bytes).
+	 * @brief Given a generic value, get the char reprsentation (i.e. as bytes). Fields are 
+	 * written little-endian in declaration order, as listed by STRUCT_MESSAGE_MAP_FIELDS.
 	 * 
 	 * @param s A pointer struct of type S
 	 * @param out A buffer of chars, of known final size based on sizeof(S).
 	 */
 	void structToStr(const S *s, char* out) const {
-		memoryCopy(out, s, this->size);
+		WireCodec<S>::encode(*s, (uint8_t*)out);
     }
 
 	/**
@@ -46,10 +68,27 @@ public:
 	 * 
 	 * @param s A pointer to struct of type S
 	 * @param buffer A string, of known initial size based on sizeof(S).
-     * 
-     * Must be instantiated by each individual class. See Translate.h
 	 */
-	void strToStruct(S *s, const char* buffer) const = delete;
+	void strToStruct(S *s, const char* buffer) const {
+		WireCodec<S>::decodeInto(s, (const uint8_t*)buffer);
+	}
+
+	/**
+	 * @brief Given a string (i.e. as bytes) of only the leading bytes of a struct, get the struct 
+	 * representation. Fields past the end of the string are zero.
+	 * 
+	 * @param s A pointer to struct of type S
+	 * @param buffer A string
+	 * @param size Number of bytes in string
+	 */
+	void strToStruct(S *s, const char* buffer, const size_t size) const {
+		if (size >= this->size) return strToStruct(s, buffer);
+
+		char full[sizeof(S)];
+		memoryCopy(full, buffer, size);
+		memorySet(full + size, 0, sizeof(S) - size);
+		strToStruct(s, full);
+	}
 
 	/**
 	 * @brief Provided a pointer to a struct, initialize and output a corresponding message.
@@ -64,6 +103,53 @@ public:
 		outMessage->init(type, this->size, buffer);
 	}
 
+	/**
+	 * @brief Provided a pointer to a struct, initialize and output a corresponding message of 
+	 * only its leading bytes. Used for structs ending in an array which is not always full.
+	 * 
+	 * @param s A pointer to a struct to translate
+	 * @param size Number of leading bytes of struct to include, at most sizeof(S)
+	 * @param outMessage Message with appropriate type and content, now initialized
+	 */
+	void asMessage(const S *s, const size_t size, Message* outMessage)
+	{
+		char buffer[MESSAGE_CONTENT_LENGTH_MAX];
+		structToStr(s, buffer);
+		outMessage->init(type, (size < this->size) ? size : this->size, buffer);
+	}
+
+	/**
+	 * @brief Provided a pointer to a struct, encode a corresponding frame of only its leading 
+	 * bytes straight into the transmit buffer. No message is built.
+	 * 
+	 * @param s A pointer to a struct to translate
+	 * @param size Number of leading bytes of struct to include, at most sizeof(S)
+	 * @param writer Writer of the transmit buffer
+	 * @return Number of bytes in frame, or 0 if the transmit buffer lacked space
+	 */
+	size_t asFrame(const S *s, const size_t size, FrameWriter* writer)
+	{
+		size_t contentSize = (size < this->size) ? size : this->size;
+		if (false == writer->begin(type, contentSize)) return 0;
+		char buffer[sizeof(S)];
+		structToStr(s, buffer);
+		writer->write(buffer, contentSize);
+		return writer->end();
+	}
+
+	/**
+	 * @brief Provided a pointer to a struct, encode a corresponding frame straight into the 
+	 * transmit buffer.
+	 * 
+	 * @param s A pointer to a struct to translate
+	 * @param writer Writer of the transmit buffer
+	 * @return Number of bytes in frame, or 0 if the transmit buffer lacked space
+	 */
+	size_t asFrame(const S *s, FrameWriter* writer)
+	{
+		return asFrame(s, this->size, writer);
+	}
+
 	/**
 	 * @brief Provided a message and pointer to a struct, populate the struct with appropriate 
 	 * information.
@@ -75,6 +161,18 @@ public:
 	{
 		char buffer[MESSAGE_CONTENT_LENGTH_MAX];
 		message->getContent(buffer);
-		strToStruct(s, buffer);
+		strToStruct(s, buffer, message->getContentSize());
+	}
+
+	/**
+	 * @brief Provided a view of a message and pointer to a struct, populate the struct with 
+	 * appropriate information. The content is read in place.
+	 * 
+	 * @param view A view of a message to translate
+	 * @param s pointer to a struct
+	 */
+	void asStruct(const MessageView* view, S *s)
+	{
+		strToStruct(s, view->getContent(), view->getContentSize());
 	}
 };
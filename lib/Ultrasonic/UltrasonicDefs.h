@@ -2,6 +2,7 @@
 #include "Settings.h"
 #include "Types.h"
 #include <DrivetrainDefs.h>
+#include <MessageSchema.h>
 
 /*****************************************************
  *                 COMPILER UTILITIES                *
@@ -13,20 +14,8 @@
  *****************************************************/
 
 /**
- * Valid messages for Ultrasonic communication
+ * UltrasonicState is generated from schema/messages.json into MessageSchema.h
  */
-enum class UltrasonicState
-{
-	Invalid,
-	NoReceived,
-	Request,
-	Rejected,
-    InProgress,
-	Success,
-	Complete,
-
-	Count
-};
 
 /**
  * State of Ultrasonic sweep
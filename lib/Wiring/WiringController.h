@@ -5,6 +5,7 @@
 #include <Lidar.h>
 #include <Ultrasonic.h>
 #include <Gripper.h>
+#include <Bluetooth.h>
 #include "Wiring.h"
 
 /**
@@ -35,6 +36,9 @@
 /* Lidar */
 #define PIN_LIDAR_MOTOCTRL 9
 
+/* Bluetooth */
+#define PIN_BLUETOOTH_KEY 22
+
 /* Gripper */
 #define PIN_GRIPPER_ARM 2
 #define PIN_GRIPPER_WRIST 3
@@ -59,7 +63,14 @@ void Wiring_InitComms(CommsInterface *externalComms, CommsInterface *peripheralC
 #if defined(USE_SERIAL)
 	externalComms->init(UART_EXTERNAL_SERIAL, EXTERNAL_COMMS_BAUD_RATE);
 #elif defined(USE_BLE)
-	externalComms->init(UART_EXTERNAL_BLE, EXTERNAL_COMMS_BAUD_RATE);
+	unsigned long externalBaud = EXTERNAL_COMMS_BAUD_RATE;
+#if BLUETOOTH_WILL_RECONFIGURE_BAUD_RATE
+	// Raise module rate, skipped if already done on an earlier startup
+	Bluetooth bluetooth;
+	bluetooth.init(UART_EXTERNAL_BLE, PIN_BLUETOOTH_KEY);
+	externalBaud = bluetooth.configure(BLUETOOTH_TARGET_BAUD_RATE);
+#endif
+	externalComms->init(UART_EXTERNAL_BLE, externalBaud);
 #endif
 
 	// Internal communications setup
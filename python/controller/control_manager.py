@@ -1,7 +1,7 @@
 import threading
 import keyboard
 from drive_control_manager import send_drive_command, send_drive_automated_command
-from lidar_control_manager import send_lidar_request
+from lidar_control_manager import send_lidar_request, request_lidar_keyframe
 from automated_command import AutomatedCommand
 from ultrasonic_control_manager import send_ultrasonic_request
 from encoder_control_manager import send_encoder_request
@@ -11,7 +11,8 @@ from mcl2.mcl_main import reset_localization
 DRIVETRAIN_KEYS = ["q", "z", "a", "d", "w", "s"]
 DRIVETRAIN_AUTOMATED_KEYS = ["y", "h", "g", "j", "t", "u"] # "b"
 CURRENT_AUTOMATED_COMMAND_KEY = "b"
-LIDAR_KEYS = ["l"]
+LIDAR_KEYS = ["l", "k"]
+LIDAR_KEYFRAME_KEY = "k"
 ULTRASONIC_KEYS = [] #["p"]
 LOCALIZATION_RESET_KEYS = ['`']
 ENCODER_KEYS = ["e"]
@@ -94,7 +95,9 @@ def start_keyboard_listener(ser, stop_event, lidar_reading, ultrasonic_reading,
             for k in LIDAR_KEYS:
                 is_pressed = keyboard.is_pressed(k)
                 if is_pressed and not lidar_pressed[k]:
-                    send_lidar_request(ser, lidar_reading, k)
+                    if k == LIDAR_KEYFRAME_KEY:
+                        request_lidar_keyframe()
+                    send_lidar_request(ser, lidar_reading)
                     lidar_pressed[k] = True  # mark as pressed
                 elif not is_pressed and lidar_pressed[k]:
                     # reset state when key released
@@ -1,11 +1,14 @@
-from message import Message, MessageType
+from message import Message, MessageType, encode_enum
 from sender import send
 import struct
 
 
 def send_drive_command(ser, key: str):
     """Send a drivetrain command over serial."""
-    msg = Message(MessageType.DrivetrainManualCommand, key.encode())
+    msg = Message(
+        MessageType.DrivetrainManualCommand,
+        encode_enum(MessageType.DrivetrainManualCommand, key),
+    )
     send(ser, msg)
 
 
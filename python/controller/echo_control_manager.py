@@ -0,0 +1,12 @@
+from message import Message, MessageType
+from sender import send
+import struct
+
+
+def send_echo_filter(ser, suppressed_types=()):
+    """Send the peripheral message types the controller board should not echo back."""
+    mask = 0
+    for message_type in suppressed_types:
+        mask |= 1 << message_type.value
+    msg = Message(MessageType.EchoFilter, struct.pack("<I", mask))
+    send(ser, msg)
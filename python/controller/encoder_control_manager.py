@@ -1,10 +1,10 @@
-from message import Message, MessageType
+from message import Message, MessageType, encode_enum
 from sender import send
 
 def send_encoder_request(ser, key: str = 'e'):
     """Send an Encoder request over serial"""
     msg = Message(
         MessageType.DrivetrainEncoderState, 
-        key.encode()
+        encode_enum(MessageType.DrivetrainEncoderState, key)
     )
     send(ser, msg)
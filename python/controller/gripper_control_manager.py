@@ -1,10 +1,10 @@
-from message import Message, MessageType
+from message import Message, MessageType, encode_enum
 from sender import send
 
 def send_gripper_request(ser, content: str):
     """Send a Gripper request over serial"""
     msg = Message(
         MessageType.GripperCommand, 
-        content.encode()
+        encode_enum(MessageType.GripperCommand, content)
     )
     send(ser, msg)
@@ -1,14 +1,32 @@
-from message import Message, MessageType
+from message import Message, MessageType, encode_enum
 from sender import send
 from lidar_reading import LidarReading
 from encoder_control_manager import send_encoder_request
 
-def send_lidar_request(ser, reading: LidarReading, key: str = 'l'):
+LIDAR_REQUEST = "l"
+LIDAR_REQUEST_KEYFRAME = "lk"
+
+# Set when the next scan must be sent in full rather than as changes to the last
+_keyframe_requested = False
+
+
+def request_lidar_keyframe():
+    """Have the next LIDAR request ask for a full scan."""
+    global _keyframe_requested
+    _keyframe_requested = True
+
+
+def send_lidar_request(ser, reading: LidarReading, key: str = LIDAR_REQUEST):
     """Send a LIDAR request over serial and clear the reading."""
+    global _keyframe_requested
+    if _keyframe_requested:
+        key = LIDAR_REQUEST_KEYFRAME
+        _keyframe_requested = False
+
     reading.clear()
     msg = Message(
         MessageType.LidarState, 
-        key.encode()
+        encode_enum(MessageType.LidarState, key)
     )
     send(ser, msg)
 
@@ -15,19 +15,26 @@ LIDAR_ZERO_ANGLE_OFFSET_SIMULATED = 0.0  # degrees
 L = 3.73771654 # inches, 94.938 mm - DISTANCE_FROM_OBJECT_CENTER_TO_WHEEL_MIDPOINT
 GRIPPER_WIDTH = 2.5
 GRIPPER_LENGTH = 6
+# Number of angular bins in a scan, corresponds to LIDAR_GRANULARITY_NUM_POINTS in Settings.h
+LIDAR_GRANULARITY_NUM_POINTS = 360
+LIDAR_SCAN_CHUNK_NO_READING = 0
+# Set on a chunk start index when it updates the last scan rather than starting a new one
+LIDAR_SCAN_CHUNK_DELTA_FLAG = 0x8000
 
 class LidarPointReading:
     """
     Represents one LIDAR beam measurement.
     - angle: degrees in range [0, 360). Stored in degrees for clarity.
     - distance: stored in **inches** (float).
+    - quality: 1 (noisy) to 15 (clean), or None if not reported.
     """
-    __slots__ = ("angle", "distance")
+    __slots__ = ("angle", "distance", "quality")
 
-    def __init__(self, angle_deg: float, distance: float):
+    def __init__(self, angle_deg: float, distance: float, quality: int = None):
         # keep angle normalized to [0,360)
         self.angle = float(angle_deg) % 360.0
         self.distance = float(distance) # already inches
+        self.quality = quality
 
     def __lt__(self, other):
         # For bisect sorting by angle
@@ -165,6 +172,46 @@ class LidarReading:
         return f"LidarReading({len(self.points)} points: {self.points})"
 
 
+class LidarScanBins:
+    """
+    Last known distance and quality of every angular bin. A keyframe scan replaces all bins, while
+    a delta scan (chunks flagged LIDAR_SCAN_CHUNK_DELTA_FLAG) only updates the bins it carries.
+    """
+    def __init__(self, num_bins: int = LIDAR_GRANULARITY_NUM_POINTS):
+        self.bins = [None] * num_bins
+        self.scan_in_progress = False
+
+    def add_scan_chunk(self, start_index: int, distances, qualities=None):
+        """
+        Apply every collected point of a LidarScanChunk or LidarScanChunkCompact. The first chunk
+        of a keyframe scan clears all bins.
+        """
+        is_delta = bool(start_index & LIDAR_SCAN_CHUNK_DELTA_FLAG)
+        start_index &= ~LIDAR_SCAN_CHUNK_DELTA_FLAG
+
+        if not self.scan_in_progress:
+            self.scan_in_progress = True
+            if not is_delta:
+                self.bins = [None] * len(self.bins)
+
+        for offset, distance in enumerate(distances):
+            if distance == LIDAR_SCAN_CHUNK_NO_READING:
+                continue
+            quality = qualities[offset] if qualities else None
+            self.bins[(start_index + offset) % len(self.bins)] = (distance, quality)
+
+    def complete_scan(self, reading: LidarReading, is_real_lidar_data: bool):
+        """Replace the contents of `reading` with every known bin, ending the current scan."""
+        self.scan_in_progress = False
+        reading.clear()
+        for index, known in enumerate(self.bins):
+            if known is None:
+                continue
+            distance, quality = known
+            angle = index * 360.0 / len(self.bins)
+            reading.add_point(LidarPointReading(angle, distance, quality), is_real_lidar_data)
+
+
 def init_lidar_plot(_lidar_fig, _lidar_ax, _lidar_scatter):
     """Initialize or recreate the LIDAR scatter plot window. Returns updated handles."""
     # If old fig exists but user closed the window → reset
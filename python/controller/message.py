@@ -1,56 +1,42 @@
 # message.py
-from enum import Enum, auto
+from enum import Enum
+import binascii
 import struct
 
-MESSAGE_END_CHAR = b"$"
+from message_schema import (
+    CHUNK_CODECS,
+    DRIVETRAIN_FIXED_POINT_ANGLE_SCALE,
+    DRIVETRAIN_FIXED_POINT_DISTANCE_SCALE,
+    ENCODER_1_TO_IN,
+    ENCODER_2_TO_IN,
+    ENCODER_3_TO_IN,
+    ENUM_STRINGS,
+    MESSAGE_DESTINATION_NAMES,
+    MessageType,
+    STRUCT_CODECS,
+    TEXT_TYPES,
+)
+
+FRAME_DELIMITER = b"\x00"
 NULL_TERMINATOR = b"\x00"
-ENCODING_MINIMUM_LENGTH = 3  # type char, size char, end char
+ENCODING_MINIMUM_LENGTH = 2  # type char, size char
+FRAME_ADDRESS_LENGTH = 1  # destination board high nibble, source board low nibble
+FRAME_CRC_LENGTH = 2  # CRC-16/CCITT-FALSE, little-endian
+FRAME_CRC_INIT = 0xFFFF
 RAD_TO_DEG = 180/3.14159
 
+# Gain of each DrivetrainEncoderTicks count, generated from schema/messages.json like the boards'
+ENCODER_TO_IN = (ENCODER_1_TO_IN, ENCODER_2_TO_IN, ENCODER_3_TO_IN)
 
-# Type of Message.
-#
-# Corresponds to lib/Message/MessageType.h
-class MessageType(Enum):
-    def _generate_next_value_(name, start, count, last_values):
-        return count
-
-    Unused = auto()
-    Generic = auto()
-    Error = auto()
-
-    DrivetrainManualCommand = auto()
-    DrivetrainManualResponse = auto()
-    DrivetrainAutomatedCommand = auto()
-    DrivetrainAutomatedResponse = auto()
-    DrivetrainEncoderState = auto()
-    DrivetrainEncoderDistances = auto()
-    DrivetrainDisplacements = auto()
-    DrivetrainMotorCommand = auto()
-
-    LidarState = auto()
-    LidarPointReading = auto()
-
-    UltrasonicState = auto()
-    UltrasonicPointReading = auto()
-    
-    GripperCommand = auto()
-    GripperState = auto()
 
-    Count = auto()
-
-
-# Registry for the format of all received content.
-#
-# Similar to Translate.h
+# How to display each received struct. Wire formats are generated into message_schema.py from
+# schema/messages.json.
 _TYPE_FORMATS = {
     MessageType.DrivetrainEncoderDistances: dict(
-        fmt="<fff",  # three float32_t
         units=("in", "in", "in"),  # three inches
         disp=["{:.2f} {u}", "{:.2f} {u}", "{:.2f} {u}"],  # display format
     ),
     MessageType.DrivetrainDisplacements: dict(
-        fmt="<fff",  # three float32_t
         units=("in", "in", "°"),  # delta x, delta y, delta theta
         disp=[
             "{:.2f} {u}", 
@@ -59,51 +45,263 @@ _TYPE_FORMATS = {
             ],  # display format
     ),
     MessageType.DrivetrainMotorCommand: dict(
-        fmt="<BfBfBf",  # three bool then float32_t
         units=("", "", "", "", "", ""),  # unitless
         disp=[
             lambda v, u: f"{'+' if v == 1 else '-'}{u}",
             "{:.2f}{u}"
             ]*3,  # display format
     ),
+    MessageType.DrivetrainEncoderTicks: dict(
+        convert=lambda v: tuple(t * g for t, g in zip(v, ENCODER_TO_IN)),  # ticks→in
+        units=("in", "in", "in"),  # three inches
+        disp=["{:.2f} {u}", "{:.2f} {u}", "{:.2f} {u}"],  # display format
+    ),
+    MessageType.DrivetrainDisplacementsFixed: dict(
+        convert=lambda v: (
+            v[0] / DRIVETRAIN_FIXED_POINT_DISTANCE_SCALE,
+            v[1] / DRIVETRAIN_FIXED_POINT_DISTANCE_SCALE,
+            v[2] / DRIVETRAIN_FIXED_POINT_ANGLE_SCALE,
+        ),  # as DrivetrainDisplacements
+        units=("in", "in", "°"),  # delta x, delta y, delta theta
+        disp=[
+            "{:.2f} {u}", 
+            "{:.2f} {u}", 
+            lambda v, u: f"{v * RAD_TO_DEG:.2f} {u}",  # rad→deg for display
+            ],  # display format
+    ),
+    MessageType.DrivetrainMotorCommandFixed: dict(
+        convert=lambda v: sum((((v[0] >> i) & 1, v[1 + i]) for i in range(3)), ()),
+        units=("", "", "", "", "", ""),  # unitless, as DrivetrainMotorCommand
+        disp=[
+            lambda v, u: f"{'+' if v == 1 else '-'}{u}",
+            "{}{u}"
+            ]*3,  # display format
+    ),
     MessageType.DrivetrainAutomatedCommand: dict(
-        fmt="<hhh",  # three int16_t
         units=("in", "in", "°"),  # delta x, delta y, delta theta
         disp=["{:.2f} {u}", "{:.2f} {u}", "{:.2f} {u}"],  # display format
     ),
     MessageType.LidarPointReading: dict(
-        fmt="<hh",  # two int16_t
         units=("°", "in"),  # degree, in
         disp=["{}{u}", "{} {u}"],  # display format
     ),
+    MessageType.LoopTimeHistogram: dict(
+        # bucket i holds loops under 2^(9+i) us, the last holds everything longer
+        units=tuple(f"<{(1 << (9 + i)) / 1000:g}ms" for i in range(11))
+        + (f">={(1 << 19) / 1000:g}ms", "us"),
+        disp="{} {u}",
+    ),
+    MessageType.DiagnosticsCounters: dict(
+        # type most passed over by pickup and its count, then relayed messages lost
+        disp=[lambda v, u: MessageType(v).name if v < MessageType.Count.value else str(v)]
+        + ["{} {u}"] * 3,
+        units=("", "passed over", "relay dropped", "relay overflowed"),
+    ),
+    MessageType.LidarScanChunkCompact: dict(
+        decoder=lambda content, count: decode_lidar_compact(content, count),
+    ),
     MessageType.UltrasonicPointReading: dict(
-        fmt="<Bffff", # a uint8_t, four float32_t
         units=("", "in", "in", "in", "in"), # which ultrasonic, three encoder readings, ultrasonic
         disp=["{}{u}", "{:.2f} {u}", "{:.2f} {u}", "{:.2f} {u}", "{:.2f} {u}"]
     ),
-    MessageType.Generic: dict(text=True),
-    MessageType.Error: dict(text=True),
 }
 
+# Enum codes are below the first printable char, strings are in ENUM_STRINGS
+ENUM_CODE_LIMIT = 0x20
+
+
+def encode_enum(type: MessageType, string: str) -> bytes:
+    """
+    Content of an enum message: the code char of its string representation, or the string
+    itself if it is not in the table, which the boards still accept.
+    """
+    strings = ENUM_STRINGS.get(type, ())
+    if string in strings:
+        return bytes([strings.index(string)])
+    return string.encode()
+
+
+def decode_enum(type: MessageType, content: bytes) -> str:
+    """
+    String representation of enum message content, either a code char or a legacy string.
+    """
+    strings = ENUM_STRINGS[type]
+    if len(content) == 1 and content[0] < ENUM_CODE_LIMIT:
+        return strings[content[0]] if content[0] < len(strings) else strings[0]
+    return content.decode(errors="replace")
+
+
 SHOULD_NOT_PRINT_TO_SCREEN = [
     # MessageType.DrivetrainEncoderDistances,
     MessageType.DrivetrainManualCommand,
     MessageType.LidarPointReading,
+    MessageType.LidarScanChunk,
+    MessageType.LidarScanChunkCompact,
 ]
 
+# Board addresses
+#
+# Corresponds to BOARD_ADDRESS_xxx in include/Settings.h
+class BoardAddress(Enum):
+    Host = 0
+    Controller = 1
+    Peripheral = 2
+
+
+# Board each MessageType sent by the host is addressed to. Anything not listed is for the
+# controller board, which forwards drivetrain commands to the peripheral board itself.
+MESSAGE_DESTINATIONS = {
+    type: BoardAddress[name] for type, name in MESSAGE_DESTINATION_NAMES.items()
+}
+
+
+def frame_address(destination: BoardAddress, source: BoardAddress = BoardAddress.Host) -> int:
+    """
+    Address char of a frame, corresponds to FRAME_ADDRESS in lib/Comms/CommsFraming.h
+    """
+    return (destination.value << 4) | source.value
+
+
+# Framing helpers
+#
+# Corresponds to lib/Comms/CommsFraming.h
+def crc16(data: bytes) -> int:
+    """
+    CRC-16/CCITT-FALSE of data.
+    """
+    return binascii.crc_hqx(data, FRAME_CRC_INIT)
+
+
+def cobs_encode(data: bytes) -> bytes:
+    """
+    COBS byte-stuff data so that it contains no zero bytes.
+    """
+    out = bytearray(b"\x00")
+    code_idx = 0
+    code = 1
+    for b in data:
+        if b == 0:
+            out[code_idx] = code
+            code_idx = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(b)
+        code += 1
+        if code == 0xFF:
+            out[code_idx] = code
+            code_idx = len(out)
+            out.append(0)
+            code = 1
+    out[code_idx] = code
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> bytes:
+    """
+    Reverse COBS byte-stuffing. Raises ValueError if stuffing is invalid.
+    """
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        code = data[idx]
+        idx += 1
+        if code == 0 or idx + code - 1 > len(data):
+            raise ValueError("Malformed COBS block")
+        block = data[idx : idx + code - 1]
+        if 0 in block:
+            raise ValueError("Malformed COBS block")
+        out.extend(block)
+        idx += code - 1
+        if code < 0xFF and idx < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(raw: bytes, address: int) -> bytes:
+    """
+    Wrap a raw message into a frame: [COBS(address + raw + CRC)][delimiter]
+    """
+    addressed = address.to_bytes(FRAME_ADDRESS_LENGTH, "little") + raw
+    payload = addressed + crc16(addressed).to_bytes(FRAME_CRC_LENGTH, "little")
+    return cobs_encode(payload) + FRAME_DELIMITER
+
+
+def decode_frame(frame: bytes):
+    """
+    Unwrap a frame (excluding delimiter) into its address and raw message. Raises ValueError if
+    damaged.
+    Returns: (address, raw)
+    """
+    payload = cobs_decode(frame)
+    if len(payload) < FRAME_ADDRESS_LENGTH + ENCODING_MINIMUM_LENGTH + FRAME_CRC_LENGTH:
+        raise ValueError("Frame too short")
+    addressed, received = payload[:-FRAME_CRC_LENGTH], payload[-FRAME_CRC_LENGTH:]
+    if crc16(addressed) != int.from_bytes(received, "little"):
+        raise ValueError("Frame CRC mismatch")
+    return addressed[0], addressed[FRAME_ADDRESS_LENGTH:]
+
+
+# Lidar compact scan helpers
+#
+# Corresponds to fillLidarScanChunkCompact in lib/Lidar/LidarDefs.h
+LIDAR_QUALITY_NO_READING = 0
+
+
+def decode_lidar_compact(encoded: bytes, count: int):
+    """
+    Decode `count` zigzag varint distance deltas followed by `count` 4-bit qualities.
+    Points not collected in the sweep have distance 0 and quality 0.
+    Returns: (distances, qualities)
+    """
+    deltas = []
+    idx = 0
+    for _ in range(count):
+        value, shift = 0, 0
+        while True:
+            if idx >= len(encoded):
+                raise ValueError("Truncated lidar varint")
+            b = encoded[idx]
+            idx += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                break
+        deltas.append((value >> 1) ^ -(value & 1))  # zigzag
+
+    if len(encoded) < idx + (count + 1) // 2:
+        raise ValueError("Truncated lidar qualities")
+    qualities = [(encoded[idx + i // 2] >> (4 * (i % 2))) & 0x0F for i in range(count)]
+
+    distances = []
+    last = 0
+    for delta, quality in zip(deltas, qualities):
+        if quality == LIDAR_QUALITY_NO_READING:
+            distances.append(0)
+            continue
+        last += delta
+        distances.append(last)
+    return tuple(distances), tuple(qualities)
+
+
 # Message class
 #
 # Corresponds to lib/Message/Message.h
 class Message:
 
-    def __init__(self, type: MessageType, content: bytes):
+    def __init__(self, type: MessageType, content: bytes, destination: BoardAddress = None):
         """
-        Construct a Message directly from type and content bytes.
+        Construct a Message directly from type and content bytes. Unless given, the destination
+        is looked up in MESSAGE_DESTINATIONS.
         """
         self.type = type
         self.content = content
         self.size = len(content)
-        self.raw = self.encode()
+        if destination is None:
+            destination = MESSAGE_DESTINATIONS.get(type, BoardAddress.Controller)
+        self.destination = destination
+        self.source = BoardAddress.Host
+        self.raw = encode_frame(self.encode(), frame_address(destination))
 
     def get_type(self):
         return self.type
@@ -114,8 +312,8 @@ class Message:
     @classmethod
     def from_raw(self, raw: bytes):
         """
-        Construct a Message object from a raw byte string.
-        Expected format: [type][size][content...]['$'][optional '\0']
+        Construct a Message object from a raw byte string, once unwrapped from its frame.
+        Expected format: [type][size][content...]
         """
         if len(raw) < ENCODING_MINIMUM_LENGTH:
             raise ValueError("Raw message too short")
@@ -130,71 +328,79 @@ class Message:
         except ValueError:
             raise ValueError(f"Invalid message type value: {type_val}")
 
-        # Extract content and validate terminator
+        # Extract content and validate size
         content = raw[2 : 2 + size]
-
-        # Validate the end char
-        expected_end = raw[2 + size : 3 + size]
-        if expected_end != MESSAGE_END_CHAR:
-            raise ValueError(f"Missing or invalid message end char: {expected_end}")
-
-        # Remove null terminator if present
-        raw = raw.rstrip(NULL_TERMINATOR)
+        if len(raw) != 2 + size:
+            raise ValueError(f"Message size {size} does not match frame ({len(raw) - 2} bytes)")
 
         # Construct message
         msg = self(msg_type, content)
-        msg.raw = raw
         return msg
 
     def encode(self) -> bytes:
         """
-        Return the full encoded message as bytes.
-        Format: [type][size][content...]['$'][optional '\0']
+        Return the raw encoded message as bytes, before framing.
+        Format: [type][size][content...]
         """
         return (
             self.type.value.to_bytes(1, "little")
             + self.size.to_bytes(1, "little")
             + self.content
-            + MESSAGE_END_CHAR
         )
 
-    def _decode_struct(self, meta):
+    def _decode_struct(self, codec, meta):
         """
         Helper to unpack struct into the format expected based on the MessageType
         """
-        fmt = meta["fmt"]
-        expected = struct.calcsize(fmt)
-        if len(self.content) != expected:
+        if len(self.content) != codec.size:
             raise ValueError(
-                f"{self.type.name}: expected {expected} bytes, got {len(self.content)}"
+                f"{self.type.name}: expected {codec.size} bytes, got {len(self.content)}"
             )
-        values = struct.unpack(fmt, self.content)
+        values = codec.unpack(self.content)
+        if "convert" in meta:
+            values = meta["convert"](values)  # fixed point to the units of the float message
         return values
 
+    def _decode_chunk(self, header, item, meta):
+        """
+        Helper to unpack a header followed by a variable number of items
+        Returns: (header values..., items)
+        """
+        if len(self.content) < header.size:
+            raise ValueError(f"{self.type.name}: content shorter than header")
+        values = header.unpack_from(self.content)
+        count = values[-1]
+        if "decoder" in meta:
+            return values[:-1] + meta["decoder"](self.content[header.size:], count)
+        items = struct.unpack_from(f"<{count}{item}", self.content, header.size)
+        return values[:-1] + (items,)
+
     def decode(self):
         """
         Decode a Message into the correct information format based on the metadata of the MessageType
         """
-        meta = _TYPE_FORMATS.get(self.type)
-        if not meta:
-            # no known structure
-            return self.content.decode(errors="replace") if self.content else None
-        if meta.get("text"):
+        if self.type in ENUM_STRINGS:
+            return decode_enum(self.type, self.content)
+        if self.type in TEXT_TYPES:
             return self.content.decode(errors="replace")
-        if "fmt" in meta:
-            return self._decode_struct(meta)
-        return self.content
+        meta = _TYPE_FORMATS.get(self.type, {})
+        if self.type in STRUCT_CODECS:
+            return self._decode_struct(STRUCT_CODECS[self.type], meta)
+        if self.type in CHUNK_CODECS:
+            return self._decode_chunk(*CHUNK_CODECS[self.type], meta)
+        # no known structure
+        return self.content.decode(errors="replace") if self.content else None
 
     def __repr__(self):
         """
         Get string representation of Message
         """
         
-        meta = _TYPE_FORMATS.get(self.type)
+        meta = _TYPE_FORMATS.get(self.type, {})
         val = self.decode()
-        if meta and "fmt" in meta:
-            # metadata will include formatting method
-            disp, units = meta["disp"], meta["units"]
+        if self.type in STRUCT_CODECS:
+            # metadata may include formatting method
+            disp, units = meta.get("disp", "{}{u}"), meta.get("units", ())
             parts = []
             for i, v in enumerate(val):
                 fmt = (
@@ -210,7 +416,11 @@ class Message:
 
             return f"<{self.type.name}({', '.join(parts)})>"
 
-        if meta and meta.get("text"):
+        if self.type in CHUNK_CODECS:
+            # display header values and items
+            return f"<{self.type.name}({', '.join(str(v) for v in val)})>"
+
+        if self.type in TEXT_TYPES or self.type in ENUM_STRINGS:
             # display raw text representation
             return f"<{self.type.name}({val})>"
 
@@ -229,20 +439,23 @@ class Message:
 #
 def parse_message_from_buffer(buffer: bytes):
     """
-    Try to parse a Message from the start of buffer.
-    Returns: (msg, bytes_consumed)
-    Raises ValueError if the message is invalid.
+    Try to parse a Message from the first frame in buffer.
+    Returns: (msg, bytes_consumed). msg is None if the frame was empty or no complete frame is
+    buffered yet (bytes_consumed is 0).
+    Raises ValueError if the frame is damaged. The caller should drop it through the delimiter.
     """
-    if len(buffer) < 2:
-        return None, 0  # not enough bytes for header
-
-    type_byte = buffer[0]
-    size = buffer[1]
-    total_len = 2 + size + 1  # type + size + content + '$'
-
-    if len(buffer) < total_len:
+    idx = buffer.find(FRAME_DELIMITER)
+    if idx < 0:
         return None, 0  # not enough bytes yet
 
-    raw_msg = buffer[:total_len]
+    total_len = idx + 1  # frame + delimiter
+    if idx == 0:
+        return None, total_len  # consecutive delimiters
+
+    address, raw_msg = decode_frame(bytes(buffer[:idx]))
     msg = Message.from_raw(raw_msg)
+    try:
+        msg.source = BoardAddress(address & 0x0F)
+    except ValueError:
+        raise ValueError(f"Invalid source board address: {address & 0x0F}")
     return msg, total_len
@@ -0,0 +1,108 @@
+# message_schema.py
+# Generated by scripts/generate_messages.py from schema/messages.json. Do not edit.
+import struct
+from enum import Enum
+from math import pi as PI
+
+
+# Scales and gains that the boards and the host both apply to wire values.
+#
+# Corresponds to the constants in lib/Message/MessageSchema.h
+WHEEL_DIAMETER_IN = 2.20472
+WHEEL_CIRCUMFERENCE_IN = 2 * PI * WHEEL_DIAMETER_IN
+DEFAULT_ENCODER_TICKS_PER_ROTATION = 1000  # approx
+DEFAULT_ENCODER_GAIN_IN = WHEEL_CIRCUMFERENCE_IN / DEFAULT_ENCODER_TICKS_PER_ROTATION
+ENCODER_1_TUNING_GAIN = 0.485
+ENCODER_2_TUNING_GAIN = 0.485
+ENCODER_3_TUNING_GAIN = 1.045
+ENCODER_1_TO_IN = DEFAULT_ENCODER_GAIN_IN * ENCODER_1_TUNING_GAIN  # DrivetrainEncoderTicks encoder1Ticks to inches
+ENCODER_2_TO_IN = DEFAULT_ENCODER_GAIN_IN * ENCODER_2_TUNING_GAIN  # DrivetrainEncoderTicks encoder2Ticks to inches
+ENCODER_3_TO_IN = DEFAULT_ENCODER_GAIN_IN * ENCODER_3_TUNING_GAIN  # DrivetrainEncoderTicks encoder3Ticks to inches
+DRIVETRAIN_FIXED_POINT_DISTANCE_SCALE = 100  # hundredths of an inch
+DRIVETRAIN_FIXED_POINT_ANGLE_SCALE = 100  # hundredths of a radian
+
+
+# Type of Message.
+#
+# Corresponds to lib/Message/MessageSchema.h
+class MessageType(Enum):
+    Unused = 0  # encodes to 0
+    Generic = 1
+    Error = 2
+    DrivetrainManualCommand = 3
+    DrivetrainManualResponse = 4
+    DrivetrainAutomatedCommand = 5
+    DrivetrainAutomatedResponse = 6
+    DrivetrainEncoderState = 7
+    DrivetrainEncoderDistances = 8
+    DrivetrainDisplacements = 9
+    DrivetrainMotorCommand = 10
+    DrivetrainEncoderTicks = 11
+    DrivetrainDisplacementsFixed = 12
+    DrivetrainMotorCommandFixed = 13
+    LidarState = 14
+    LidarPointReading = 15
+    LidarScanChunk = 16
+    LidarScanChunkCompact = 17
+    UltrasonicState = 18
+    UltrasonicPointReading = 19
+    GripperCommand = 20
+    GripperState = 21
+    LinkControl = 22  # stays between the boards, never forwarded
+    LoopTimeHistogram = 23
+    EchoFilter = 24  # host to controller board, types of peripheral messages not echoed
+    DiagnosticsCounters = 25  # counts since startup of traffic each board passed over or lost
+    Count = 26
+
+
+# Board each MessageType sent by the host is addressed to, by BoardAddress name. Anything not
+# listed is for the controller board.
+MESSAGE_DESTINATION_NAMES = {
+    MessageType.DrivetrainEncoderState: "Peripheral",
+}
+
+# Types whose content is text.
+TEXT_TYPES = frozenset((
+    MessageType.Generic,
+    MessageType.Error,
+))
+
+# String representation of each enum value, indexed by the code char sent in its place.
+#
+# Corresponds to the EnumStringMap tables in lib/Translate/TranslateSchema.h
+ENUM_STRINGS = {
+    MessageType.DrivetrainManualCommand: ("invalid", "", "w", "s", "a", "d", "z", "h", "auto"),
+    MessageType.DrivetrainManualResponse: ("invalid", "", "ackval", "notifhalt", "notifbrake"),
+    MessageType.DrivetrainAutomatedResponse: ("invalid", "", "ack", "inprog", "overshot", "attarget", "abort"),
+    MessageType.DrivetrainEncoderState: ("invalid", "", "e"),
+    MessageType.LidarState: ("invalid", "", "l", "lk", "reject", "notopen", "cannotscan", "cannotverify", "unhealthy", "success", "complete"),
+    MessageType.UltrasonicState: ("invalid", "", "p", "rejected", "inprog", "success", "complete"),
+    MessageType.GripperCommand: ("invalid", "", "home", "extend", "ready", "open", "close", "ping"),
+    MessageType.GripperState: ("invalid", "", "home", "ready_c", "ready_o", "ext_c", "ext_o"),
+}
+
+# Codec of each struct of fixed size, little-endian and packed.
+#
+# Corresponds to STRUCT_MESSAGE_MAP_FIELDS in lib/Translate/TranslateSchema.h
+STRUCT_CODECS = {
+    MessageType.DrivetrainAutomatedCommand: struct.Struct("<hhh"),
+    MessageType.DrivetrainEncoderDistances: struct.Struct("<fff"),
+    MessageType.DrivetrainDisplacements: struct.Struct("<fff"),
+    MessageType.DrivetrainMotorCommand: struct.Struct("<BfBfBf"),
+    MessageType.DrivetrainEncoderTicks: struct.Struct("<iii"),
+    MessageType.DrivetrainDisplacementsFixed: struct.Struct("<hhh"),
+    MessageType.DrivetrainMotorCommandFixed: struct.Struct("<BBBB"),
+    MessageType.LidarPointReading: struct.Struct("<hh"),
+    MessageType.UltrasonicPointReading: struct.Struct("<Bffff"),
+    MessageType.LinkControl: struct.Struct("<BB8B"),
+    MessageType.LoopTimeHistogram: struct.Struct("<12HI"),
+    MessageType.EchoFilter: struct.Struct("<I"),
+    MessageType.DiagnosticsCounters: struct.Struct("<BHHH"),
+}
+
+# Codec of the header of each struct ending in a variable number of items, whose count is the
+# last header field, and the format of one item.
+CHUNK_CODECS = {
+    MessageType.LidarScanChunk: (struct.Struct("<HB"), "h"),
+    MessageType.LidarScanChunkCompact: (struct.Struct("<HB"), "B"),
+}
@@ -4,12 +4,19 @@ import sys
 import serial
 from message import (
     Message,
-    MESSAGE_END_CHAR,
+    FRAME_DELIMITER,
     parse_message_from_buffer,
     MessageType,
     SHOULD_NOT_PRINT_TO_SCREEN,
 )
-from lidar_reading import LidarPointReading, LidarReading, init_lidar_plot, update_lidar_plot
+from lidar_reading import (
+    LidarPointReading,
+    LidarReading,
+    LidarScanBins,
+    init_lidar_plot,
+    update_lidar_plot,
+)
+from lidar_control_manager import request_lidar_keyframe
 from ultrasonic_reading import UltrasonicPointReading, UltrasonicReading
 from automated_command import AutomatedCommand
 from encoder_reading import EncoderReading
@@ -41,6 +48,7 @@ def start_receiver(ser, stop_event, lidar_reading: LidarReading, ultrasonic_read
         buffer = bytearray()
         synced = False
         lidar_reading_ready_for_localization = False
+        lidar_scan_bins = LidarScanBins()
         waiting_on_ultrasonic_encoder = False
         waiting_on_ultrasonic_vis = False
 
@@ -63,10 +71,10 @@ def start_receiver(ser, stop_event, lidar_reading: LidarReading, ultrasonic_read
 
                 buffer.extend(data)
 
-                # Step 1: synchronize to first '$'
+                # Step 1: synchronize to first frame delimiter
                 if not synced:
-                    if MESSAGE_END_CHAR in buffer:
-                        idx = buffer.index(MESSAGE_END_CHAR)
+                    if FRAME_DELIMITER in buffer:
+                        idx = buffer.index(FRAME_DELIMITER)
                         buffer = buffer[idx + 1 :]
                         synced = True
                         print("[Receiver synchronized to stream]")
@@ -102,8 +110,21 @@ def start_receiver(ser, stop_event, lidar_reading: LidarReading, ultrasonic_read
                                 )
                                 lidar_reading.add_point(point, is_real_lidar_data=True)
 
+                            elif msg.type == MessageType.LidarScanChunk:
+                                start_index, distances = msg.decode()
+                                lidar_scan_bins.add_scan_chunk(start_index, distances)
+
+                            elif msg.type == MessageType.LidarScanChunkCompact:
+                                start_index, distances, qualities = msg.decode()
+                                lidar_scan_bins.add_scan_chunk(
+                                    start_index, distances, qualities
+                                )
+
                             elif msg.type == MessageType.LidarState:
-                                if msg.get_content() == b"complete":  # complete
+                                if msg.decode() == "complete":  # complete
+                                    lidar_scan_bins.complete_scan(
+                                        lidar_reading, is_real_lidar_data=True
+                                    )
                                     # Ping encoder after receiving a complete lidar scan
                                     send_encoder_request(ser)
                                     lidar_reading_ready_for_localization = True
@@ -131,7 +152,7 @@ def start_receiver(ser, stop_event, lidar_reading: LidarReading, ultrasonic_read
                                 ultrasonic_reading.add_point(point)
 
                             elif msg.type == MessageType.UltrasonicState:
-                                if msg.get_content() == b"complete":  # complete
+                                if msg.decode() == "complete":  # complete
                                     # Ping encoder after receiving a complete ultrasonic scan
                                     send_encoder_request(ser)
                                     waiting_on_ultrasonic_encoder = True
@@ -143,7 +164,10 @@ def start_receiver(ser, stop_event, lidar_reading: LidarReading, ultrasonic_read
                                     current_automated_command.make_complete()
 
                             # --- ENCODER integration ---
-                            elif msg.type == MessageType.DrivetrainEncoderDistances:
+                            elif msg.type in (
+                                MessageType.DrivetrainEncoderDistances,
+                                MessageType.DrivetrainEncoderTicks,
+                            ):
                                 current_encoder_reading.update_from_msg(msg)
 
                                 # Initialize last_sent_encoder_reading if None
@@ -177,20 +201,21 @@ def start_receiver(ser, stop_event, lidar_reading: LidarReading, ultrasonic_read
                                 print_rcvd_message(msg)
                             buffer = buffer[consumed:]
                             continue
+                        if consumed:
+                            buffer = buffer[consumed:]  # empty frame
+                            continue
                         break  # not enough data yet
                     except ValueError as e:
-                        hex_str = " ".join(f"{b:02X}" for b in buffer)
+                        # Drop only the damaged frame, stream stays synchronized at its delimiter
+                        idx = buffer.index(FRAME_DELIMITER)
+                        hex_str = " ".join(f"{b:02X}" for b in buffer[: idx + 1])
                         print(
-                            f"[Receiver decode error: {e}] Raw ({len(buffer)} bytes): {hex_str}"
+                            f"[Receiver dropped frame: {e}] Raw ({idx + 1} bytes): {hex_str}"
                         )
-                        # Skip until next '$'
-                        if MESSAGE_END_CHAR in buffer:
-                            idx = buffer.index(MESSAGE_END_CHAR)
-                            buffer = buffer[idx + 1 :]
-                        else:
-                            buffer.clear()
-                        synced = False
-                        break
+                        buffer = buffer[idx + 1 :]
+                        # A lost chunk leaves stale bins until a full scan is received
+                        request_lidar_keyframe()
+                        continue
 
             except serial.SerialException as e:
                 print("\n[Serial connection lost : {e}]")
@@ -1,4 +1,4 @@
-from message import Message, MessageType
+from message import Message, MessageType, encode_enum
 from sender import send
 from ultrasonic_reading import UltrasonicReading
 from encoder_control_manager import send_encoder_request
@@ -8,7 +8,7 @@ def send_ultrasonic_request(ser, reading: UltrasonicReading, key: str = 'p'):
     reading.clear()
     msg = Message(
         MessageType.UltrasonicState, 
-        key.encode()
+        encode_enum(MessageType.UltrasonicState, key)
     )
     send(ser, msg)
 
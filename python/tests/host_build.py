@@ -0,0 +1,82 @@
+# host_build.py
+#
+# Build the boards' sources for the host, against the Arduino stand-in in test/host, so they can be
+# run by tests here. Needs g++ on the PATH.
+#
+# Run by hand to build and run one harness: python python/tests/host_build.py <harness> <board>
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+REPO_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+HOST_DIR = os.path.join(REPO_DIR, "test", "host")
+LIB_DIR = os.path.join(REPO_DIR, "lib")
+
+BOARD_DEFINES = {
+    "controller": "BOARD_CONTROLLER",
+    "peripheral": "BOARD_PERIPHERAL",
+}
+
+# Sources every harness links, relative to the repository
+COMMON_SOURCES = (
+    "test/host/Arduino.cpp",
+    "lib/Comms/Comms.cpp",
+    "lib/Comms/CommsFrameWriter.cpp",
+    "lib/Comms/CommsFraming.cpp",
+    "lib/Comms/CommsInterface.cpp",
+    "lib/Message/Message.cpp",
+    "lib/Message/MessagePool.cpp",
+    "lib/RingBuffer/ByteRingBuffer.cpp",
+    "lib/RingBuffer/RingBuffer.cpp",
+    "lib/Taskmaster/Taskmaster.cpp",
+    "lib/Translate/TranslateSchema.cpp",
+)
+
+# Sources of each harness by board, beyond its own file in test/host
+HARNESS_SOURCES = {
+    ("BluetoothConfigure", "controller"): ("lib/Bluetooth/Bluetooth.cpp",),
+    ("LinkBoard", "controller"): ("src/controller/PeripheralLink.cpp",),
+    ("LinkBoard", "peripheral"): ("src/peripheral/LinkController.cpp",),
+    ("LoopTime", "controller"): (),
+    ("QueueHubBench", "controller"): (),
+    ("WeightedPickup", "controller"): (),
+}
+
+
+def have_compiler() -> bool:
+    return shutil.which("g++") is not None
+
+
+def build(harness: str, board: str, out_dir: str = None) -> str:
+    """
+    Compile a harness in test/host for a board.
+    Returns: path of the executable
+    """
+    out_dir = out_dir or tempfile.mkdtemp(prefix="host_build_")
+    executable = os.path.join(out_dir, f"{harness}_{board}")
+    sources = (
+        (f"test/host/{harness}.cpp",)
+        + COMMON_SOURCES
+        + HARNESS_SOURCES.get((harness, board), ())
+    )
+    includes = [HOST_DIR, os.path.join(REPO_DIR, "include"), os.path.join(REPO_DIR, "src", board)]
+    includes += sorted(
+        os.path.join(LIB_DIR, d) for d in os.listdir(LIB_DIR) if os.path.isdir(os.path.join(LIB_DIR, d))
+    )
+    command = (
+        ["g++", "-std=gnu++11", "-O2", f"-D{BOARD_DEFINES[board]}"]
+        + [f"-I{d}" for d in includes]
+        + [os.path.join(REPO_DIR, s) for s in sources]
+        + ["-o", executable]
+    )
+    subprocess.run(command, check=True)
+    return executable
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        sys.exit(f"Usage: {sys.argv[0]} <harness> <board> [args...]")
+    executable = build(sys.argv[1], sys.argv[2])
+    sys.exit(subprocess.call([executable] + sys.argv[3:]))
@@ -0,0 +1,150 @@
+# test_bluetooth_configure.py
+#
+# Run the controller board's Bluetooth module startup on the host against a scripted HC-05 style
+# module on the other end of a pty. The module answers AT commands only while the board's port is
+# at the rate the module listens at, as a real module's UART would.
+#
+# Run with: python -m unittest discover python/tests
+import os
+import pty
+import select
+import subprocess
+import sys
+import tempfile
+import termios
+import threading
+import tty
+import unittest
+
+sys.path.insert(0, os.path.dirname(__file__))
+import host_build
+
+BLUETOOTH_AT_BAUD = termios.B38400  # BLUETOOTH_AT_BAUD_RATE
+EXTERNAL_BAUD = 9600  # EXTERNAL_COMMS_BAUD_RATE
+TARGET_BAUD = 115200  # BLUETOOTH_TARGET_BAUD_RATE
+EEPROM_MARKER = 0xB7  # BLUETOOTH_EEPROM_CONFIGURED_MARKER
+KEY_PIN = 7  # HOST_PIN_BLUETOOTH_KEY in test/host/BluetoothConfigure.cpp
+
+
+class FakeModule(threading.Thread):
+    """
+    Scripted module: answers each command line with OK while the port is at listen_speed, and
+    records every command it understood. A silent module never answers.
+    """
+
+    def __init__(self, listen_speed=BLUETOOTH_AT_BAUD, silent=False):
+        super().__init__(daemon=True)
+        self.listen_speed = listen_speed
+        self.silent = silent
+        self.commands = []
+        self.master, self.slave = pty.openpty()
+        tty.setraw(self.slave)
+        self.slave_path = os.ttyname(self.slave)
+        self.is_running = True
+
+    def run(self):
+        line = b""
+        while self.is_running:
+            readable, _, _ = select.select([self.master], [], [], 0.05)
+            if not readable:
+                continue
+            try:
+                data = os.read(self.master, 256)
+            except OSError:
+                continue
+            # A module at another rate only sees noise
+            if termios.tcgetattr(self.master)[5] != self.listen_speed:
+                line = b""
+                continue
+            line += data
+            while b"\r\n" in line:
+                command, line = line.split(b"\r\n", 1)
+                self.commands.append(command.decode(errors="replace"))
+                if not self.silent:
+                    os.write(self.master, b"OK\r\n")
+
+    def close(self):
+        self.is_running = False
+        self.join()
+        os.close(self.master)
+        os.close(self.slave)
+
+
+@unittest.skipUnless(host_build.have_compiler(), "needs g++")
+class BluetoothConfigureTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.board = host_build.build("BluetoothConfigure", "controller")
+
+    def setUp(self):
+        self.eeprom_path = os.path.join(tempfile.mkdtemp(prefix="eeprom_"), "eeprom.bin")
+
+    def start_board(self, module):
+        """
+        Run configure against a module.
+        Returns: (rate configure returned, KEY pin values written in order)
+        """
+        module.start()
+        try:
+            output = subprocess.run(
+                [self.board, module.slave_path, str(TARGET_BAUD)],
+                env=dict(os.environ, HOST_EEPROM_PATH=self.eeprom_path),
+                stdout=subprocess.PIPE,
+                text=True,
+                timeout=20,
+                check=True,
+            ).stdout
+        finally:
+            module.close()
+
+        configured, key = None, []
+        for line in output.splitlines():
+            fields = line.split()
+            if fields[0] == "configured":
+                configured = int(fields[1])
+            elif len(fields) == 4 and fields[1] == "pin" and int(fields[2]) == KEY_PIN:
+                key.append(int(fields[3]))
+        return configured, key
+
+    def eeprom_record(self):
+        """
+        Returns: (marker, baud) of the configured record, or None if never written
+        """
+        if not os.path.exists(self.eeprom_path):
+            return None
+        with open(self.eeprom_path, "rb") as f:
+            record = f.read(5)
+        return record[0], int.from_bytes(record[1:5], "little")
+
+    def test_reprograms_module_and_records_it(self):
+        module = FakeModule()
+        configured, key = self.start_board(module)
+        self.assertEqual(configured, TARGET_BAUD)
+        self.assertEqual(module.commands, ["AT", f"AT+UART={TARGET_BAUD},0,0", "AT+RESET"])
+        self.assertEqual(key, [0, 1, 0], "KEY must be raised for AT mode and lowered for reset")
+        self.assertEqual(self.eeprom_record(), (EEPROM_MARKER, TARGET_BAUD))
+
+    def test_skips_at_mode_once_configured(self):
+        self.start_board(FakeModule())
+        module = FakeModule()
+        configured, key = self.start_board(module)
+        self.assertEqual(configured, TARGET_BAUD)
+        self.assertEqual(module.commands, [])
+        self.assertNotIn(1, key)
+
+    def test_finds_module_listening_at_another_rate(self):
+        module = FakeModule(listen_speed=termios.B9600)
+        configured, _ = self.start_board(module)
+        self.assertEqual(configured, TARGET_BAUD)
+        self.assertIn(f"AT+UART={TARGET_BAUD},0,0", module.commands)
+
+    def test_silent_module_keeps_default_rate(self):
+        module = FakeModule(silent=True)
+        configured, key = self.start_board(module)
+        self.assertEqual(configured, EXTERNAL_BAUD)
+        self.assertEqual(key[-1], 0, "module must be left in data mode")
+        self.assertIsNone(self.eeprom_record())
+
+
+if __name__ == "__main__":
+    unittest.main()
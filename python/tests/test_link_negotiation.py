@@ -0,0 +1,156 @@
+# test_link_negotiation.py
+#
+# Run both boards' ends of the internal link on the host, each on its own pty, with this test
+# relaying bytes between them in place of the wires. Bytes are garbled whenever the two ends are at
+# different rates, or above the fastest rate the "wires" carry, as a UART would garble them.
+#
+# Run with: python -m unittest discover python/tests
+import os
+import pty
+import select
+import subprocess
+import sys
+import termios
+import threading
+import time
+import tty
+import unittest
+
+sys.path.insert(0, os.path.dirname(__file__))
+import host_build
+
+# termios speeds by baud rate, as set by test/host/Arduino.cpp
+TTY_SPEEDS = {
+    9600: termios.B9600,
+    38400: termios.B38400,
+    57600: termios.B57600,
+    115200: termios.B115200,
+    250000: termios.B230400,
+}
+BASE_BAUD = 9600  # INTERNAL_COMMS_BAUD_RATE
+FASTEST_BAUD = 250000  # rate index LINK_BAUD_RATE_INDEX_MAX
+
+
+class LinkWires(threading.Thread):
+    """
+    Relay bytes between two pty masters, garbling them across a rate mismatch or above
+    max_speed.
+    """
+
+    def __init__(self, max_speed=termios.B230400):
+        super().__init__(daemon=True)
+        self.max_speed = max_speed
+        self.masters = []
+        # Slaves stay open here so each pty survives a board reopening it
+        self.slave_fds = []
+        self.slave_paths = []
+        for _ in range(2):
+            master, slave = pty.openpty()
+            tty.setraw(slave)
+            self.masters.append(master)
+            self.slave_fds.append(slave)
+            self.slave_paths.append(os.ttyname(slave))
+        self.is_running = True
+
+    def speed(self, index):
+        return termios.tcgetattr(self.masters[index])[5]
+
+    def carries(self):
+        speeds = (self.speed(0), self.speed(1))
+        return speeds[0] == speeds[1] and speeds[0] <= self.max_speed
+
+    def run(self):
+        while self.is_running:
+            readable, _, _ = select.select(self.masters, [], [], 0.05)
+            for master in readable:
+                try:
+                    data = os.read(master, 1024)
+                except OSError:
+                    continue
+                if not self.carries():
+                    data = bytes(b ^ 0xA5 for b in data)
+                os.write(self.masters[1 - self.masters.index(master)], data)
+
+    def close(self):
+        self.is_running = False
+        self.join()
+        for fd in self.masters + self.slave_fds:
+            os.close(fd)
+
+
+def baud_changes(output: str, port: str):
+    """
+    Rate changes printed by a board, as (ms, baud)
+    """
+    changes = []
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[1] == port and fields[2] == "begin":
+            changes.append((int(fields[0]), int(fields[3])))
+    return changes
+
+
+@unittest.skipUnless(host_build.have_compiler(), "needs g++")
+class LinkNegotiationTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.controller = host_build.build("LinkBoard", "controller")
+        cls.peripheral = host_build.build("LinkBoard", "peripheral")
+
+    def run_link(self, duration_ms, max_speed=termios.B230400, max_speed_later=None):
+        """
+        Run both boards for duration_ms, optionally limiting the wires to max_speed_later halfway.
+        Returns: (controller rate changes, peripheral rate changes)
+        """
+        wires = LinkWires(max_speed)
+        wires.start()
+        boards = [
+            subprocess.Popen(
+                [exe, path, str(duration_ms)], stdout=subprocess.PIPE, text=True
+            )
+            for exe, path in zip((self.controller, self.peripheral), wires.slave_paths)
+        ]
+        if max_speed_later is not None:
+            time.sleep(duration_ms / 2000)
+            wires.max_speed = max_speed_later
+        outputs = [board.communicate(timeout=duration_ms / 1000 + 10)[0] for board in boards]
+        wires.close()
+        return baud_changes(outputs[0], "Serial1"), baud_changes(outputs[1], "Serial")
+
+    def assertSettles(self, changes, baud, duration_ms, stable_ms):
+        self.assertTrue(changes, "board never opened the link")
+        last_ms, last_baud = changes[-1]
+        self.assertEqual(last_baud, baud, f"rate changes: {changes}")
+        self.assertLess(last_ms, duration_ms - stable_ms, f"still changing rate: {changes}")
+
+    def test_idle_link_keeps_fastest_rate(self):
+        """
+        Nothing but negotiation crosses the link. It must commit the fastest rate and keep it.
+        """
+        controller, peripheral = self.run_link(8000)
+        self.assertSettles(controller, FASTEST_BAUD, 8000, 5000)
+        self.assertSettles(peripheral, FASTEST_BAUD, 8000, 5000)
+
+    def test_steps_down_to_fastest_rate_carried(self):
+        """
+        Rates above 57600 garble. Faster candidates must fail their tests, and 57600 be kept.
+        """
+        controller, peripheral = self.run_link(10000, max_speed=termios.B57600)
+        self.assertSettles(controller, 57600, 10000, 3000)
+        self.assertSettles(peripheral, 57600, 10000, 3000)
+        self.assertIn((FASTEST_BAUD), [baud for _, baud in controller], "fastest never tried")
+
+    def test_falls_back_when_committed_rate_degrades(self):
+        """
+        The committed fastest rate starts garbling. Both boards must fall back and renegotiate.
+        """
+        controller, peripheral = self.run_link(
+            14000, max_speed_later=termios.B115200
+        )
+        self.assertIn(FASTEST_BAUD, [baud for _, baud in controller])
+        self.assertSettles(controller, 115200, 14000, 2000)
+        self.assertSettles(peripheral, 115200, 14000, 2000)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,53 @@
+# test_weighted_pickup.py
+#
+# Run a controller's weighted pickup on the host, through the Taskmaster's collect() over many
+# loops, and check that each Response type is collected in proportion to its weight while a
+# Control type is collected in between.
+#
+# Run with: python -m unittest discover python/tests
+import os
+import subprocess
+import sys
+import unittest
+
+sys.path.insert(0, os.path.dirname(__file__))
+import host_build
+
+BAUD = 9600  # slow enough that the Response types compete for the port every loop
+DURATION = 3000  # millis
+HEAVY_WEIGHT = 3  # DrivetrainDisplacements in test/host/WeightedPickup.cpp
+LIGHT_WEIGHT = 1  # DrivetrainEncoderDistances
+
+
+@unittest.skipUnless(host_build.have_compiler(), "needs g++")
+class WeightedPickupTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        board = host_build.build("WeightedPickup", "controller")
+        output = subprocess.run(
+            [board, str(BAUD), str(DURATION)],
+            stdout=subprocess.PIPE,
+            text=True,
+            timeout=DURATION / 1000 + 20,
+            check=True,
+        ).stdout
+        cls.counts = {}
+        for line in output.splitlines():
+            fields = line.split()
+            if len(fields) == 2 and fields[0] in ("heavy", "light", "bulk"):
+                cls.counts[fields[0]] = int(fields[1])
+
+    def test_share_follows_weights(self):
+        heavy, light = self.counts["heavy"], self.counts["light"]
+        self.assertGreater(heavy + light, 20, "too few collected to judge the share")
+        # Within one turn of each at either end of the run
+        total = heavy + light
+        expected = total * HEAVY_WEIGHT / (HEAVY_WEIGHT + LIGHT_WEIGHT)
+        self.assertLessEqual(abs(heavy - expected), HEAVY_WEIGHT + LIGHT_WEIGHT, self.counts)
+
+    def test_bulk_waits_behind_response(self):
+        self.assertEqual(self.counts["bulk"], 0, self.counts)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,424 @@
+# generate_messages.py
+#
+# Generate the C++ and Python message tables from schema/messages.json, so the boards and the host
+# can not drift apart. Run by PlatformIO before every build (extra_scripts in platformio.ini), or
+# by hand with `python scripts/generate_messages.py`. Files are only rewritten when they change.
+import ast
+import json
+import os
+import re
+import struct
+
+SCHEMA = os.path.join("schema", "messages.json")
+OUT_MESSAGE_SCHEMA_H = os.path.join("lib", "Message", "MessageSchema.h")
+OUT_TRANSLATE_SCHEMA_H = os.path.join("lib", "Translate", "TranslateSchema.h")
+OUT_TRANSLATE_SCHEMA_CPP = os.path.join("lib", "Translate", "TranslateSchema.cpp")
+OUT_PYTHON = os.path.join("python", "controller", "message_schema.py")
+
+GENERATED_NOTE = "Generated by scripts/generate_messages.py from schema/messages.json. Do not edit."
+
+BOARD_GUARDS = {
+    "controller": "defined(BOARD_CONTROLLER)",
+    "peripheral": "defined(BOARD_PERIPHERAL)",
+}
+
+# Wire type: Python struct format char
+SCALAR_FORMATS = {
+    "bool": "B",
+    "u8": "B",
+    "i8": "b",
+    "u16": "H",
+    "i16": "h",
+    "u32": "I",
+    "i32": "i",
+    "f32": "f",
+}
+
+FIELD_TYPE = re.compile(r"^(\w+)(?:\[(\d*)\])?$")
+
+# Syntax a constant's value may use, so that it reads the same in C++ and Python
+CONSTANT_NODES = (
+    ast.Expression, ast.BinOp, ast.UnaryOp, ast.Add, ast.Sub, ast.Mult, ast.Div, ast.USub,
+    ast.Constant, ast.Name, ast.Load,
+)
+
+
+def banner(title: str) -> str:
+    """
+    Section banner, as used across the C++ sources.
+    """
+    width = 51
+    left = (width - len(title)) // 2
+    return (
+        "/*****************************************************\n"
+        f" *{' ' * left}{title}{' ' * (width - left - len(title))}*\n"
+        " *****************************************************/\n"
+    )
+
+
+class Schema:
+    def __init__(self, path: str):
+        with open(path) as f:
+            raw = json.load(f)
+        self.priorities = raw["priorities"]
+        self.enums = raw["enums"]
+        self.messages = raw["messages"]
+        self.constants = raw.get("constants", [])
+        self.structs = {m["name"]: m for m in self.messages if m.get("kind") == "struct"}
+        self.default_priority = next(p["name"] for p in self.priorities if p.get("default"))
+        self._validate()
+
+    def _validate(self):
+        names = [m["name"] for m in self.messages]
+        if len(names) != len(set(names)):
+            raise ValueError("Message names must be unique")
+        if len(names) > 32:
+            raise ValueError("MessageType must be uniquely captured in a messageTypeMask")
+        enums = {e["name"]: e for e in self.enums}
+        for m in self.messages:
+            if m.get("kind") == "enum" and m["name"] not in enums:
+                raise ValueError(f"No enum values for {m['name']}")
+            for name, wire in m.get("fields", ()):
+                self.parse_field(wire)
+        for e in self.enums:
+            strings = [s for _, s in e["values"] if s]
+            if len(strings) != len(set(strings)):
+                raise ValueError(f"{e['name']} strings are not unique")
+        known = {"PI"}
+        for c in self.constants:
+            for node in ast.walk(ast.parse(c["value"], mode="eval")):
+                if not isinstance(node, CONSTANT_NODES):
+                    raise ValueError(f"{c['name']} must be arithmetic on numbers and earlier constants")
+                if isinstance(node, ast.Name) and node.id not in known:
+                    raise ValueError(f"{c['name']} uses {node.id} before it is defined")
+            known.add(c["name"])
+
+    def parse_field(self, wire: str):
+        """
+        Returns: (element type, count), count is None for a scalar and 0 for a trailing array of
+        any length.
+        """
+        match = FIELD_TYPE.match(wire)
+        if not match or (match.group(1) not in SCALAR_FORMATS and match.group(1) not in self.structs):
+            raise ValueError(f"Unknown field type {wire}")
+        element, count = match.group(1), match.group(2)
+        if count is None:
+            return element, None
+        return element, int(count) if count else 0
+
+    def element_format(self, element: str) -> str:
+        if element in SCALAR_FORMATS:
+            return SCALAR_FORMATS[element]
+        return "".join(self.field_format(w) for _, w in self.structs[element]["fields"])
+
+    def field_format(self, wire: str) -> str:
+        element, count = self.parse_field(wire)
+        fmt = self.element_format(element)
+        if count is None:
+            return fmt
+        return f"{count}{fmt}" if len(fmt) == 1 else fmt * count
+
+    def element_size(self, element: str) -> int:
+        return struct.calcsize("<" + self.element_format(element))
+
+    def is_variable(self, message) -> bool:
+        return any(self.parse_field(w)[1] == 0 for _, w in message.get("fields", ()))
+
+    def board_of(self, item) -> str:
+        return item.get("board", "")
+
+
+def guarded(items, board_of, emit) -> list:
+    """
+    Emit lines for each item, grouping the items of each board under its #if guard.
+    """
+    lines = []
+    for board in [""] + list(BOARD_GUARDS):
+        group = [i for i in items if board_of(i) == board]
+        if not group:
+            continue
+        if board:
+            lines.append(f"#if {BOARD_GUARDS[board]}")
+        for item in group:
+            lines.extend(emit(item))
+        if board:
+            lines.append("#endif")
+    return lines
+
+
+def generate_message_schema_h(schema: Schema) -> str:
+    out = ["#pragma once", f"/* {GENERATED_NOTE} */", '#include "Types.h"', ""]
+
+    out.append(banner("MESSAGE TYPES"))
+    out.append("/**")
+    out.append(" * @brief Define all possible Message types.")
+    out.append(" * Every Message object will begin with a char denoting the type of message")
+    out.append(" * ")
+    out.append(" */")
+    out.append("enum class MessageType {")
+    for m in schema.messages:
+        doc = f" // {m['doc']}" if "doc" in m else ""
+        out.append(f"\t{m['name']},{doc}")
+    out.append("")
+    out.append("\tCount")
+    out.append("};")
+    out.append("")
+
+    out.append("/**")
+    out.append(" * @brief Classes of outbound traffic, in order of transmit priority. Every queued message of a ")
+    out.append(" * class is collected before any of the next.")
+    out.append(" * ")
+    out.append(" */")
+    out.append("enum class MessagePriority : uint8_t {")
+    for p in schema.priorities:
+        out.append(f"\t{p['name']}, // {p['doc']}")
+    out.append("")
+    out.append("\tCount")
+    out.append("};")
+    out.append("")
+
+    out.append("/**")
+    out.append(" * @brief Get the priority class of a MessageType")
+    out.append(" * ")
+    out.append(" */")
+    out.append("constexpr MessagePriority messagePriorityOf(MessageType type)")
+    out.append("{")
+    out.append("\treturn")
+    for p in schema.priorities:
+        if p.get("default"):
+            continue
+        members = [m["name"] for m in schema.messages if m.get("priority") == p["name"]]
+        if not members:
+            continue
+        out.append("\t\t(")
+        out.append(" ||\n".join(f"\t\t\t(type == MessageType::{n})" for n in members))
+        out.append(f"\t\t) ? MessagePriority::{p['name']} :")
+    out.append(f"\t\tMessagePriority::{schema.default_priority};")
+    out.append("}")
+    out.append("")
+
+    out.append("/**")
+    out.append(" * @brief Whether a MessageType stays between the two boards of a link, rather than being ")
+    out.append(" * addressed to the host")
+    out.append(" * ")
+    out.append(" */")
+    out.append("constexpr bool messageIsLinkLocal(MessageType type)")
+    out.append("{")
+    local = [m["name"] for m in schema.messages if m.get("link_local")]
+    out.append("\treturn " + (" ||\n\t\t".join(f"(type == MessageType::{n})" for n in local) or "false") + ";")
+    out.append("}")
+    out.append("")
+
+    out.append(banner("ENUMS"))
+    for e in schema.enums:
+        out.append("/**")
+        out.append(f" * {e['doc']}")
+        out.append(" */")
+        out.append(f"enum class {e['name']}")
+        out.append("{")
+        for value, _ in e["values"]:
+            out.append(f"\t{value},")
+        out.append("")
+        out.append("\tCount")
+        out.append("};")
+        out.append("")
+
+    out.append(banner("CONSTANTS"))
+    out.append("/**")
+    out.append(" * @brief Scales and gains that the boards and the host both apply to wire values")
+    out.append(" * ")
+    out.append(" */")
+    for c in schema.constants:
+        doc = f" // {c['doc']}" if "doc" in c else ""
+        out.append(f"#define {c['name']} ({c['value']}){doc}")
+    out.append("")
+
+    return "\n".join(out)
+
+
+def generate_translate_schema_h(schema: Schema) -> str:
+    enum_messages = [m for m in schema.messages if m.get("kind") == "enum"]
+    struct_messages = [m for m in schema.messages if m.get("kind") == "struct"]
+    enums = {e["name"]: e for e in schema.enums}
+
+    out = ["#pragma once", f"/* {GENERATED_NOTE} */", "#include <MessageType.h>"]
+    headers = {}
+    for m in struct_messages:
+        headers.setdefault(m["header"], schema.board_of(m))
+        if headers[m["header"]] != schema.board_of(m):
+            headers[m["header"]] = ""  # needed by every board
+    out.extend(guarded(list(headers), lambda h: headers[h], lambda h: [f"#include <{h}>"]))
+    out.append('#include "TranslateEnumDefs.h"')
+    out.append('#include "TranslateStructDefs.h"')
+    out.append("")
+
+    out.append(banner("ENUM MAPPING"))
+    def emit_map(m):
+        values = enums[m["name"]]["values"]
+        width = max(len(v) for v, _ in values) + 2
+        lines = [f"static constexpr EnumStringMap {m['name']}Map[] PROGMEM = {{"]
+        for value, string in values:
+            entry = f"{m['name']}::{value},".ljust(len(m["name"]) + 2 + width)
+            lines.append(f"    ENUM_MAP_ENTRY({entry} \"{string}\"),")
+        lines.append("};")
+        lines.append(f"COMPILE_TIME_ENFORCE_ENUM_MAP_COUNT({m['name']}Map, {m['name']});")
+        lines.append("")
+        return lines
+    out.extend(guarded(enum_messages, schema.board_of, emit_map))
+    out.append("")
+
+    out.append(banner("STRUCT MAPPING"))
+    def emit_fields(m):
+        names = [name for name, _ in m["fields"]]
+        lines = [f"STRUCT_MESSAGE_MAP_FIELDS({m['name']}, {', '.join(names)});"]
+        for name, wire in m["fields"]:
+            element, count = schema.parse_field(wire)
+            if count == 0:
+                lines.append(
+                    f"COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE({m['name']}, {name}[0], "
+                    f"{schema.element_size(element)});"
+                )
+            else:
+                size = schema.element_size(element) * (count or 1)
+                lines.append(f"COMPILE_TIME_ENFORCE_SCHEMA_FIELD_SIZE({m['name']}, {name}, {size});")
+        return lines
+    out.extend(guarded(struct_messages, schema.board_of, emit_fields))
+    out.append("")
+
+    out.append(banner("TRANSLATIONS"))
+    out.append("/**")
+    out.append(" * @brief Declare all EnumMessageMap and StructMessageMap objects for translation, each defined ")
+    out.append(" * once in TranslateSchema.cpp")
+    out.append(" * ")
+    out.append(" */")
+    out.extend(guarded(
+        enum_messages + struct_messages, schema.board_of,
+        lambda m: [f"{m['kind'].upper()}_MESSAGE_MAP_TRANSLATION({m['name']})"]
+    ))
+    out.append("")
+    return "\n".join(out)
+
+
+def generate_translate_schema_cpp(schema: Schema) -> str:
+    out = [f"/* {GENERATED_NOTE} */", "#include <Translate.h>", ""]
+    out.append(banner("INSTANCES"))
+    messages = [m for m in schema.messages if m.get("kind") in ("enum", "struct")]
+    out.extend(guarded(
+        messages, schema.board_of,
+        lambda m: [f"{m['kind'].upper()}_MESSAGE_MAP_DEFINITION({m['name']})"]
+    ))
+    out.append("")
+    return "\n".join(out)
+
+
+def generate_python(schema: Schema) -> str:
+    out = [
+        "# message_schema.py", f"# {GENERATED_NOTE}", "import struct", "from enum import Enum",
+        "from math import pi as PI", "", "",
+    ]
+
+    out.append("# Scales and gains that the boards and the host both apply to wire values.")
+    out.append("#")
+    out.append("# Corresponds to the constants in lib/Message/MessageSchema.h")
+    for c in schema.constants:
+        doc = f"  # {c['doc']}" if "doc" in c else ""
+        out.append(f"{c['name']} = {c['value']}{doc}")
+    out.append("")
+    out.append("")
+
+    out.append("# Type of Message.")
+    out.append("#")
+    out.append("# Corresponds to lib/Message/MessageSchema.h")
+    out.append("class MessageType(Enum):")
+    for value, m in enumerate(schema.messages):
+        doc = f"  # {m['doc']}" if "doc" in m else ""
+        out.append(f"    {m['name']} = {value}{doc}")
+    out.append(f"    Count = {len(schema.messages)}")
+    out.append("")
+    out.append("")
+
+    out.append("# Board each MessageType sent by the host is addressed to, by BoardAddress name. Anything not")
+    out.append("# listed is for the controller board.")
+    out.append("MESSAGE_DESTINATION_NAMES = {")
+    for m in schema.messages:
+        if "host_destination" in m:
+            out.append(f"    MessageType.{m['name']}: \"{m['host_destination']}\",")
+    out.append("}")
+    out.append("")
+
+    out.append("# Types whose content is text.")
+    out.append("TEXT_TYPES = frozenset((")
+    for m in schema.messages:
+        if m.get("kind") == "text":
+            out.append(f"    MessageType.{m['name']},")
+    out.append("))")
+    out.append("")
+
+    out.append("# String representation of each enum value, indexed by the code char sent in its place.")
+    out.append("#")
+    out.append("# Corresponds to the EnumStringMap tables in lib/Translate/TranslateSchema.h")
+    out.append("ENUM_STRINGS = {")
+    enums = {e["name"]: e for e in schema.enums}
+    for m in schema.messages:
+        if m.get("kind") == "enum":
+            strings = [f"\"{s}\"" for _, s in enums[m["name"]]["values"]]
+            out.append(f"    MessageType.{m['name']}: ({', '.join(strings)}{',' if len(strings) == 1 else ''}),")
+    out.append("}")
+    out.append("")
+
+    out.append("# Codec of each struct of fixed size, little-endian and packed.")
+    out.append("#")
+    out.append("# Corresponds to STRUCT_MESSAGE_MAP_FIELDS in lib/Translate/TranslateSchema.h")
+    out.append("STRUCT_CODECS = {")
+    for m in schema.messages:
+        if m.get("kind") == "struct" and not schema.is_variable(m):
+            fmt = "".join(schema.field_format(w) for _, w in m["fields"])
+            out.append(f"    MessageType.{m['name']}: struct.Struct(\"<{fmt}\"),")
+    out.append("}")
+    out.append("")
+
+    out.append("# Codec of the header of each struct ending in a variable number of items, whose count is the")
+    out.append("# last header field, and the format of one item.")
+    out.append("CHUNK_CODECS = {")
+    for m in schema.messages:
+        if m.get("kind") == "struct" and schema.is_variable(m):
+            header = "".join(schema.field_format(w) for _, w in m["fields"][:-1])
+            element, _ = schema.parse_field(m["fields"][-1][1])
+            out.append(
+                f"    MessageType.{m['name']}: (struct.Struct(\"<{header}\"), "
+                f"\"{schema.element_format(element)}\"),"
+            )
+    out.append("}")
+    out.append("")
+    return "\n".join(out)
+
+
+def write_if_changed(root: str, path: str, content: str) -> bool:
+    full = os.path.join(root, path)
+    if os.path.exists(full):
+        with open(full) as f:
+            if f.read() == content:
+                return False
+    with open(full, "w", newline="\n") as f:
+        f.write(content)
+    return True
+
+
+def generate(root: str):
+    schema = Schema(os.path.join(root, SCHEMA))
+    outputs = {
+        OUT_MESSAGE_SCHEMA_H: generate_message_schema_h(schema),
+        OUT_TRANSLATE_SCHEMA_H: generate_translate_schema_h(schema),
+        OUT_TRANSLATE_SCHEMA_CPP: generate_translate_schema_cpp(schema),
+        OUT_PYTHON: generate_python(schema),
+    }
+    for path, content in outputs.items():
+        if write_if_changed(root, path, content):
+            print(f"Generated {path}")
+
+
+if "Import" in globals():  # run by PlatformIO
+    Import("env")  # noqa: F821
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+elif __name__ == "__main__":
+    generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
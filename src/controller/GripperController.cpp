@@ -40,9 +40,6 @@ void GripperController::checkGripperCommand(void)
 
         // If this is not a ping, store as actionable
         this->lastReceivedActionableCommand = command;
-
-		// Eliminate stale messages
-		this->purge(MessageType::GripperCommand);
 	}
 }
 
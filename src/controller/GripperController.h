@@ -8,10 +8,10 @@
  *                INPUT / OUTPUT TYPES               *
  *****************************************************/
 using MessageTypesInGripper = MessageTypes<
-    MessageType::GripperCommand // Gripper request
+    Mailbox<MessageType::GripperCommand> // Gripper request
 >;
 using MessageTypesOutGripper = MessageTypes<
-    MessageType::GripperState // Gripper state
+    Fifo<MessageType::GripperState> // Gripper state
 >;
 
 /*****************************************************
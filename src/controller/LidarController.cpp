@@ -12,6 +12,10 @@ LidarController::LidarController(Lidar* lidar, PeripheralEnvoy* envoy) :
 	lidar(lidar),
 	envoy(envoy),
 	reading({0}),
+	lastSentDistance{0},
+	numScansSinceKeyframe(0),
+	hasKeyframeRequest(true), // nothing sent yet to change from
+	isSendingChanges(false),
 	hasUnaddressedRequest(false),
 	lastCompleteSentTime(0),
 	hasNotSentComplete(false) {}
@@ -30,7 +34,8 @@ void LidarController::checkLidarState(void)
 	if (ret == ControllerMessageQueueOutput::DequeueSuccess)
 	{
 		// Confirm message is a request, so it's valid
-		if (LidarStateTranslation.asEnum(&message) != LidarState::Request)
+		LidarState state = LidarStateTranslation.asEnum(&message);
+		if ((state != LidarState::Request) && (state != LidarState::RequestKeyframe))
 			return;
 
 		// Determine if request is valid
@@ -39,15 +44,14 @@ void LidarController::checkLidarState(void)
 			// Accept
 			this->hasUnaddressedRequest = true;
 			this->reading = {0};
+			if (state == LidarState::RequestKeyframe)
+				this->hasKeyframeRequest = true;
 		}
 		else
 		{
 			// Reject
 			this->sendLidarState(LidarState::Rejected);
 		}
-
-		// Eliminate stale requests
-		this->purge(MessageType::LidarState);
 	}
 }
 
@@ -67,10 +71,61 @@ void LidarController::refreshLidarReading(void)
 	
 	// Clear unaddressed request on successful ping
 	if (result == LidarState::Success)
+	{
 		this->hasUnaddressedRequest = false;
+		this->reduceLidarReadingToSend();
+	}
 
 	// Send state
 	this->sendLidarState(result);
+
+	// Nothing may have changed since the last scan sent
+	if ((result == LidarState::Success) && isLidarReadingFullyProcessed(&(this->reading)))
+	{
+		this->lastCompleteSentTime = millis();
+		this->hasNotSentComplete = true;
+	}
+}
+
+/**
+ * @brief Determine if the next reading should be sent in full rather than as changes
+ * 
+ */
+bool LidarController::shouldSendKeyframe(void)
+{
+	return (
+		// Sending changes is disabled
+		(false == LIDAR_WILL_SEND_DELTA_SCANS) ||
+		// Host has requested, or nothing sent yet
+		this->hasKeyframeRequest ||
+		// Periodic refresh
+		(this->numScansSinceKeyframe >= LIDAR_DELTA_SCAN_KEYFRAME_PERIOD)
+	);
+}
+
+/**
+ * @brief Reduce a new reading to the points that must be sent, either all points as a keyframe or 
+ * only points changed since the last reading
+ * 
+ */
+void LidarController::reduceLidarReadingToSend(void)
+{
+	if (this->shouldSendKeyframe())
+	{
+		recordLidarReadingKeyframe(&(this->reading), this->lastSentDistance);
+		this->numScansSinceKeyframe = 0;
+		this->hasKeyframeRequest = false;
+		this->isSendingChanges = false;
+		return;
+	}
+
+	reduceLidarReadingToChanges(
+		&(this->reading), 
+		this->lastSentDistance, 
+		LIDAR_DELTA_SCAN_THRESHOLD_IN
+	);
+	this->numScansSinceKeyframe++;
+	this->isSendingChanges = true;
 }
 
 /**
@@ -127,30 +182,34 @@ bool LidarController::shouldSendLidarReading(void)
 }
 
 /**
- * @brief Try to send a single Lidar point reading.
+ * @brief Try to write the next run of Lidar point readings straight into the transmit buffer.
  * 
- * @return Whether post was successful. If false, messages out queue was likely full
+ * @return Number of bytes written. If 0, transmit buffer was full
  */
-bool LidarController::trySendNextLidarReadingPoint(void)
+size_t LidarController::tryWriteNextLidarScanChunk(FrameWriter* writer)
 {
-	// Find next point to send
-	stepLidarReadingToNextValidPoint(&(this->reading));
-	LidarPointReading* currentPoint = getCurrentLidarPointReading(&(this->reading));
-	
-	// Construct message
-	Message message;
-	LidarPointReadingTranslation.asMessage(currentPoint, &message);
-	
-	// Post message
-	ControllerMessageQueueOutput result = this->post(&message);
+	// Gather next points to send
+#if LIDAR_WILL_USE_COMPACT_SCAN_ENCODING
+	LidarScanChunkCompact chunk;
+	size_t size = fillLidarScanChunkCompact(&(this->reading), &chunk);
+	lidarPointIndex startIndex = chunk.startIndex;
+	if (this->isSendingChanges) chunk.startIndex |= LIDAR_SCAN_CHUNK_DELTA_FLAG;
+	size_t frameSize = LidarScanChunkCompactTranslation.asFrame(&chunk, size, writer);
+#else
+	LidarScanChunk chunk;
+	fillLidarScanChunk(&(this->reading), &chunk);
+	lidarPointIndex startIndex = chunk.startIndex;
+	if (this->isSendingChanges) chunk.startIndex |= LIDAR_SCAN_CHUNK_DELTA_FLAG;
+	size_t frameSize = LidarScanChunkTranslation.asFrame(&chunk, LIDAR_SCAN_CHUNK_SIZE(chunk.numPoints), writer);
+#endif
 
-	// Notify if post was unsuccessful
-	if (result != ControllerMessageQueueOutput::EnqueueSuccess)
-		return false;
+	// Notify if write was unsuccessful
+	if (frameSize == 0)
+		return 0;
 
-	// Mark point as processed
-	markLidarReadingIndexProcessed(&(this->reading));
-	return true;
+	// Mark points as processed
+	markLidarReadingRangeProcessed(&(this->reading), startIndex, chunk.numPoints);
+	return frameSize;
 }
 
 /**
@@ -169,19 +228,28 @@ void LidarController::sendLidarState(LidarState state)
 }
 
 /**
- * @brief Send Lidar data points
+ * @brief Send Lidar data points, written straight into the transmit buffer rather than posted, 
+ * as they are the bulk of all output
  * 
+ * @param writer Writer of the transmit buffer
+ * @param numBytesBudget Bytes that may be written
+ * @return Number of bytes written
  */
-void LidarController::sendLidarData(void)
+size_t LidarController::stream(FrameWriter* writer, size_t numBytesBudget)
 {
-	Message message;
-	bool messageQueueMayHaveSpace = true;
+	if (false == this->shouldSendLidarReading())
+		return 0;
+
+	size_t numBytesWritten = 0;
 	while (
-		messageQueueMayHaveSpace &&
+		(numBytesWritten < numBytesBudget) &&
 		(false == isLidarReadingFullyProcessed(&(this->reading)))
 	)
 	{
-		messageQueueMayHaveSpace = this->trySendNextLidarReadingPoint();
+		size_t frameSize = this->tryWriteNextLidarScanChunk(writer);
+		if (frameSize == 0)
+			break;
+		numBytesWritten += frameSize;
 	}
 
 	// If all data sent, mark as complete
@@ -190,20 +258,7 @@ void LidarController::sendLidarData(void)
 		this->lastCompleteSentTime = millis();
 		this->hasNotSentComplete = true;
 	}
-}
-
-/**
- * @brief Determine if Lidar should request prioiritzed sender. Do so if a request has been 
- * received but the data is not stale.
- * 
- * @return true 
- * @return false 
- */
-bool LidarController::shouldRequestPrioritizedSender(void)
-{
-	return (
-		(false == shouldAcceptNewRequests())
-	);
+	return numBytesWritten;
 }
 
 /**
@@ -215,27 +270,13 @@ void LidarController::process(void)
 	// Monitor incoming messages
 	this->checkLidarState();
 
-	// Check if should request prioritized sender
-	if (this->shouldRequestPrioritizedSender())
-	{
-		this->setRequestPrioritizedSender();
-	}
-	else
-	{
-		this->clearRequestPrioritizedSender();
-	}
-
 	// Ping lidar if required
 	if (this->shouldRefreshLidarReading())
 	{
 		this->refreshLidarReading();
 	}
 
-	// Send as much Lidar infromation as possible
-	if (this->shouldSendLidarReading())
-	{
-		this->sendLidarData();
-	}
+	// Lidar information is streamed by the Taskmaster
 
 	// Notify complete if required
 	if (this->hasNotSentComplete == true)
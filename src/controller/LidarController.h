@@ -9,11 +9,11 @@
  *                INPUT / OUTPUT TYPES               *
  *****************************************************/
 using MessageTypesInLidar = MessageTypes<
-    MessageType::LidarState // Request for Lidar ping
+    Mailbox<MessageType::LidarState> // Request for Lidar ping
 >;
 using MessageTypesOutLidar = MessageTypes<
-    MessageType::LidarPointReading, // Single Lidar point reading
-	MessageType::LidarState // Indicates if read successful/failure and when sent
+	Fifo<MessageType::LidarState> // Indicates if read successful/failure and when sent
+	// LIDAR_SCAN_CHUNK_MESSAGE_TYPE runs of consecutive Lidar point readings are streamed
 >;
 
 /*****************************************************
@@ -41,6 +41,15 @@ private:
 	 */
 	LidarReading reading;
 
+	/**
+	 * @brief Last Lidar data sent, to send only changes between keyframes
+	 * 
+	 */
+	lidarDistance_in lastSentDistance[LIDAR_GRANULARITY_NUM_POINTS];
+	uint8_t numScansSinceKeyframe;
+	bool hasKeyframeRequest;
+	bool isSendingChanges;
+
 	/**
 	 * Whether a request was received and not yet addressed
 	 */
@@ -53,24 +62,25 @@ private:
 	 * 
 	 */
 	void refreshLidarReading(void);
+	void reduceLidarReadingToSend(void);
 
 	/**
 	 * @brief Communication utilities
 	 */
 	void checkLidarState(void);
-	bool trySendNextLidarReadingPoint(void);
+	size_t tryWriteNextLidarScanChunk(FrameWriter* writer);
 	void sendLidarState(LidarState state);
-	void sendLidarData(void);
 
 	/**
 	 * @brief Process utilities
 	 */
 	bool hasUnsentReading(void);
 	bool shouldAcceptNewRequests(void);
+	bool shouldSendKeyframe(void);
 	bool shouldRefreshLidarReading(void);
 	bool shouldSendLidarReading(void);
-	bool shouldRequestPrioritizedSender(void);
 public:
 	LidarController(Lidar* lidar, PeripheralEnvoy* envoy);
 	void process(void);
+	size_t stream(FrameWriter* writer, size_t numBytesBudget);
 };
\ No newline at end of file
@@ -4,11 +4,12 @@
 #include <CommsInterface.h>
 #include <Taskmaster.h>
 #include "PeripheralEnvoy.h"
-#include "PeripheralEcho.h"
+#include "PeripheralLink.h"
 #include "PeripheralForwardingController.h"
 #include "LidarController.h"
 #include "UltrasonicController.h"
 #include "GripperController.h"
+#include <DiagnosticsController.h>
 #include "Settings.h"
 #include "Errors.h"
 
@@ -18,6 +19,7 @@
 CommsInterface g_externalComms;
 CommsInterface g_peripheralComms;
 PeripheralEnvoy g_envoyToPeripheral(&g_peripheralComms);
+PeripheralLink g_peripheralLink(&g_peripheralComms, &g_envoyToPeripheral);
 
 /*****************************************************
  *                    CONTROLLERS                    *
@@ -34,27 +36,29 @@ UltrasonicController g_ultrasonicController(
 );
 Gripper g_gripper;
 GripperController g_gripperController(&g_gripper);
+DiagnosticsController g_diagnosticsController;
 
 /*****************************************************
  *                    TASKMASTERS                    *
  *****************************************************/
+static CommsInterface* primaryPorts[] = {
+	&g_externalComms, // Host
+	&g_peripheralComms // Peripheral board
+};
+static const uint8_t primaryAddressRoutes[BOARD_ADDRESS_COUNT] = {
+	0, // BOARD_ADDRESS_HOST
+	TASKMASTER_ROUTE_SELF, // BOARD_ADDRESS_CONTROLLER
+	1 // BOARD_ADDRESS_PERIPHERAL
+};
 static ControllerGeneric* primaryControllers[] = {
 	&g_peripheralForwardingController,
 	&g_lidarController,
     &g_ultrasonicController,
-    &g_gripperController
+    &g_gripperController,
+    &g_diagnosticsController,
+	&g_peripheralLink
 };
-TASKMASTER_DECLARE(primaryTaskmaster, &g_externalComms, primaryControllers)
-
-/*****************************************************
- *                  PERIPHERAL ECHO                  *
- *****************************************************/
-
-PeripheralEcho g_peripheralEcho(
-	&g_peripheralComms, // Read from peripheral
-	&g_externalComms,  // Echo on external
-	&primaryTaskmaster // Priority sending
-);
+TASKMASTER_DECLARE(primaryTaskmaster, primaryPorts, primaryAddressRoutes, primaryControllers)
 
 
 /**
@@ -68,6 +72,9 @@ void setup()
 	Wiring_InitLidar(&g_lidar);
     Wiring_InitUltrasonics(&g_ultrasonic1, &g_ultrasonic2);
     Wiring_InitGripper(&g_gripper);
+
+	// Controllers reporting on the Taskmaster
+	g_diagnosticsController.init(&primaryTaskmaster);
 }
 
 /**
@@ -75,7 +82,9 @@ void setup()
  */
 void loop()
 {
+	time_us loopStartTime = micros();
+
 	primaryTaskmaster.execute();
 
-	g_peripheralEcho.process();
+	g_diagnosticsController.recordLoop(micros() - loopStartTime);
 }
\ No newline at end of file
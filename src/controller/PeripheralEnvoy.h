@@ -9,12 +9,15 @@ private:
 	CommsInterface* toSend;
 
 	/**
-	 * @brief Envoy message on comms interface
+	 * @brief Envoy message on comms interface, addressed to the peripheral board
 	 * 
 	 */
 	void envoy(Message *message)
 	{
-		this->toSend->sendMessage(message);
+		this->toSend->sendMessage(
+			message, 
+			FRAME_ADDRESS(BOARD_ADDRESS_PERIPHERAL, BOARD_ADDRESS_SELF)
+		);
 	}
 
 public:
@@ -66,4 +69,18 @@ public:
 		);
 		this->envoy(&message);
 	}
+
+	/**
+	 * @brief Envoy link negotiation on comms interface
+	 *
+	 */
+	void envoyLinkControl(LinkControl *control)
+	{
+		Message message;
+		LinkControlTranslation.asMessage(
+			control, 
+			&message
+		);
+		this->envoy(&message);
+	}
 };
\ No newline at end of file
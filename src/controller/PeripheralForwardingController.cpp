@@ -5,71 +5,27 @@
 /**
  * @brief Construct a new PeripheralForwardingController
  * 
- * @param envoy To send encoder requests to peripheral board
+ * @param envoy To send drivetrain commands to peripheral board
  */
 PeripheralForwardingController::PeripheralForwardingController(PeripheralEnvoy *envoy) :
 	envoy(envoy),
-    hasUnaddressedEncoderRequest(false),
 	drivetrainManualCommand(DrivetrainManualCommand::NoReceived),
-    drivetrainManualCommandLastReceivedTime(0),
 	drivetrainAutomatedCommand({0}),
-    drivetrainAutomatedCommandLastReceivedTime(0) {}
+    hasUnforwardDrivetrainAutomatedCommand(false),
+	echoFilter({0}),
+    blockingExternalDrivetrainCommands(false),
+    hasInternalDrivetrainCommand(false),
+    internalDrivetrainCommand({0}) {}
 
 /**
- * @brief Read input messages for DrivetrainEncoderState type
- * 
- */
-void PeripheralForwardingController::checkEncoderState(void)
-{
-	// Dequeue DrivetrainEncoderState
-	Message message;
-	ControllerMessageQueueOutput ret = \
-		this->read(MessageType::DrivetrainEncoderState, &message);
-	
-	if (ret == ControllerMessageQueueOutput::DequeueSuccess)
-	{
-		// This controller only handles only requests for localization
-		if (
-			DrivetrainEncoderStateTranslation.asEnum(&message) != DrivetrainEncoderState::Request
-		)
-			return;
-
-		this->hasUnaddressedEncoderRequest = true;
-
-		// Eliminate stale messages
-		this->purge(MessageType::DrivetrainEncoderState);
-	}
-}
-
-/**
- * @brief Ping encoder for a reading
- * 
- */
-void PeripheralForwardingController::envoyEncoderRequest(void)
-{
-	this->envoy->envoyEncoderRequest(); // request from localization
-	this->hasUnaddressedEncoderRequest = false;
-}
-
-/**
- * @brief Determine if encoder should be pinged
- * 
- * @return if should ping
- */
-bool PeripheralForwardingController::shouldEnvoyEncoderRequest(void)
-{
-	return (
-		// Addressing a request
-		this->hasUnaddressedEncoderRequest
-	);
-}
-
-/**
- * @brief Read input messages for DrivetrainManualCommand type
+ * @brief Read input messages for DrivetrainManualCommand type. Left queued while external 
+ * commands are blocked, so a command that goes stale in the meantime is dropped by its queue.
  * 
  */
 void PeripheralForwardingController::checkDrivetrainManualCommand(void)
 {
+	if (this->blockingExternalDrivetrainCommands) return;
+
 	// Dequeue DrivetrainManualCommand
 	Message message;
 	ControllerMessageQueueOutput ret = \
@@ -78,7 +34,6 @@ void PeripheralForwardingController::checkDrivetrainManualCommand(void)
 	if (ret == ControllerMessageQueueOutput::DequeueSuccess)
 	{
 		this->drivetrainManualCommand = DrivetrainManualCommandTranslation.asEnum(&message);
-		this->drivetrainManualCommandLastReceivedTime = millis();
 	}
 }
 
@@ -108,29 +63,14 @@ bool PeripheralForwardingController::shouldEnvoyDrivetrainManualCommand(void)
 }
 
 /**
- * @brief Check if drivetrain manual command is stale. Discard if stale.
- * 
- * @return Whether command was not stale
- */
-bool PeripheralForwardingController::validateDrivetrainManualCommandFresh(void)
-{
-	if (
-		(millis() - this->drivetrainManualCommandLastReceivedTime) >
-		DRIVETRAIN_MANUAL_COMMAND_FORWARDING_TIME_TO_DISCARD
-	)
-	{
-		this->drivetrainManualCommand = DrivetrainManualCommand::NoReceived;
-		return false;
-	}
-	return true;
-}
-
-/**
- * @brief Read input messages for DrivetrainAutomatedCommand type
+ * @brief Read input messages for DrivetrainAutomatedCommand type. Left queued while external 
+ * commands are blocked, as for DrivetrainManualCommand.
  * 
  */
 void PeripheralForwardingController::checkDrivetrainAutomatedCommand(void)
 {
+	if (this->blockingExternalDrivetrainCommands) return;
+
 	// Dequeue DrivetrainAutomatedCommand
 	Message message;
 	ControllerMessageQueueOutput ret = \
@@ -139,7 +79,6 @@ void PeripheralForwardingController::checkDrivetrainAutomatedCommand(void)
 	if (ret == ControllerMessageQueueOutput::DequeueSuccess)
 	{
 		DrivetrainAutomatedCommandTranslation.asStruct(&message, &this->drivetrainAutomatedCommand);
-		this->drivetrainAutomatedCommandLastReceivedTime = millis();
         this->hasUnforwardDrivetrainAutomatedCommand = true;
 	}
 }
@@ -171,6 +110,37 @@ bool PeripheralForwardingController::shouldEnvoyDrivetrainAutomatedCommand(void)
 	);
 }
 
+/**
+ * @brief Read input messages for EchoFilter type. The latest filter replaces any before it.
+ * 
+ */
+void PeripheralForwardingController::checkEchoFilter(void)
+{
+	// Dequeue EchoFilter
+	Message message;
+	ControllerMessageQueueOutput ret = \
+		this->read(MessageType::EchoFilter, &message);
+	
+	if (ret == ControllerMessageQueueOutput::DequeueSuccess)
+		EchoFilterTranslation.asStruct(&message, &this->echoFilter);
+}
+
+/**
+ * @brief Check if the host has suppressed echoing peripheral messages of a MessageType. Only 
+ * frames relayed to the host are filtered.
+ * 
+ * @param type 
+ * @param destination Board the frame is addressed to
+ * @return Whether the frame is not relayed
+ */
+bool PeripheralForwardingController::isRelaySuppressed(MessageType type, uint8_t destination)
+{
+	return (
+		(destination == BOARD_ADDRESS_HOST) &&
+		isEchoSuppressed(&this->echoFilter, type)
+	);
+}
+
 /**
  * @brief Forward internal drivetrain automated command
  *  
@@ -222,29 +192,20 @@ void PeripheralForwardingController::provideInternalDrivetrainCommand(
 }
 
 /**
- * @brief Send encoder information upon request or periodically
+ * @brief Forward the latest drivetrain commands to the peripheral board
  * 
  */
 void PeripheralForwardingController::process(void)
 {
 	// Monitor incoming messages
-	this->checkEncoderState();
 	this->checkDrivetrainManualCommand();
 	this->checkDrivetrainAutomatedCommand();
-
-	// Check if should ping encoders
-	if (this->shouldEnvoyEncoderRequest())
-	{
-		this->envoyEncoderRequest();
-	}
+	this->checkEchoFilter();
 
 	// Check if should send drivetrain manual commands
 	if (this->shouldEnvoyDrivetrainManualCommand())
 	{
-		if (this->validateDrivetrainManualCommandFresh())
-		{
-			this->envoyDrivetrainManualCommand();
-		}
+		this->envoyDrivetrainManualCommand();
 	}
 
 	// Check if should send drivetrain automated commands
@@ -2,15 +2,22 @@
 #include "Types.h"
 #include <CommsInterface.h>
 #include <Controller.h>
+#include <CommsEchoDefs.h>
 #include "PeripheralEnvoy.h"
 
 /*****************************************************
  *                INPUT / OUTPUT TYPES               *
  *****************************************************/
 using MessageTypesInForwarding = MessageTypes<
-    MessageType::DrivetrainEncoderState, // Request for Encoder readings,
-	MessageType::DrivetrainManualCommand, // Commands for drivetrain
-    MessageType::DrivetrainAutomatedCommand // Automated commands for drivetrain
+	Expiring<
+		Mailbox<MessageType::DrivetrainManualCommand>,
+		DRIVETRAIN_MANUAL_COMMAND_FORWARDING_TIME_TO_DISCARD
+	>, // Commands for drivetrain
+    Expiring<
+		Mailbox<MessageType::DrivetrainAutomatedCommand>,
+		DRIVETRAIN_AUTOMATED_COMMAND_FORWARDING_TIME_TO_DISCARD
+	>, // Automated commands for drivetrain
+	Mailbox<MessageType::EchoFilter> // Peripheral messages to echo to the host
 >;
 using MessageTypesOutForwarding = MessageTypes<>;
 
@@ -28,17 +35,11 @@ private:
 	 */
 	PeripheralEnvoy* envoy;
 
-	/**
-	 * Whether an encoder request was received and not yet addressed
-	 */
-	bool hasUnaddressedEncoderRequest;
-
 	/**
 	 * @brief Current DrivetrainManualCommand to send
 	 * 
 	 */
 	DrivetrainManualCommand drivetrainManualCommand;
-	time_ms drivetrainManualCommandLastReceivedTime;
 
 	/**
 	 * @brief Current DrivetrainAutomatedCommand to send
@@ -46,7 +47,12 @@ private:
 	 */
 	DrivetrainAutomatedCommand drivetrainAutomatedCommand;
     bool hasUnforwardDrivetrainAutomatedCommand;
-	time_ms drivetrainAutomatedCommandLastReceivedTime;
+
+	/**
+	 * @brief Peripheral messages not echoed to the host, set by the host
+	 * 
+	 */
+	EchoFilter echoFilter;
 
     /**
      * @brief Allow other controllers to override supplied manual and automatic commands,
@@ -57,20 +63,12 @@ private:
     bool hasInternalDrivetrainCommand;
     DrivetrainAutomatedCommand internalDrivetrainCommand;
 
-	/**
-	 * @brief Encoder utilities
-	 */
-	void checkEncoderState(void);
-	void envoyEncoderRequest(void);
-	bool shouldEnvoyEncoderRequest(void);
-
 	/**
 	 * @brief Drivetrain manual command utilities
 	 */
 	void checkDrivetrainManualCommand(void);
 	void envoyDrivetrainManualCommand(void);
 	bool shouldEnvoyDrivetrainManualCommand(void);
-	bool validateDrivetrainManualCommandFresh(void);
     
 	/**
 	 * @brief Drivetrain automated command utilities
@@ -79,6 +77,11 @@ private:
 	void envoyDrivetrainAutomatedCommand(void);
 	bool shouldEnvoyDrivetrainAutomatedCommand(void);
 
+	/**
+	 * @brief Echo filter utilities
+	 */
+	void checkEchoFilter(void);
+
     /**
      * @brief Internal drivetrain control interface
      * 
@@ -89,5 +92,6 @@ public:
 	PeripheralForwardingController(PeripheralEnvoy* envoy);
     void blockExternalDrivetrainCommands(bool shouldBlock);
     void provideInternalDrivetrainCommand(DrivetrainAutomatedCommand* command);
+	bool isRelaySuppressed(MessageType type, uint8_t destination);
 	void process(void);
 };
\ No newline at end of file
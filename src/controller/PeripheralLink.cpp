@@ -0,0 +1,249 @@
+#include "PeripheralLink.h"
+#include "Settings.h"
+#include <Translate.h>
+
+/**
+ * @brief Construct a new PeripheralLink
+ * 
+ * @param comms Interface to the peripheral board
+ * @param envoy Envoy on that interface
+ */
+PeripheralLink::PeripheralLink(CommsInterface* comms, PeripheralEnvoy* envoy) :
+	comms(comms),
+	envoy(envoy),
+	stage(LINK_WILL_NEGOTIATE_BAUD_RATE ? PeripheralLinkStage::Offering : PeripheralLinkStage::Settled),
+	rateIndexCeiling(LINK_BAUD_RATE_INDEX_MAX),
+	rateIndex(LINK_BAUD_RATE_INDEX_BASE),
+	lastStageChangeTime(0),
+	lastSentTime(0),
+	numTestsSent(0),
+	numTestEchoesReceived(0),
+	lastHeartbeatEchoTime(0),
+	lastMonitorTime(0),
+	lastNumReceivedFrames(0),
+	lastNumDroppedFrames(0) {}
+
+/**
+ * @brief Send a LinkControl to the peripheral board
+ * 
+ * @param operation 
+ * @param rateIndex 
+ */
+void PeripheralLink::send(LinkOperation operation, uint8_t rateIndex)
+{
+	LinkControl control;
+	fillLinkControl(&control, operation, rateIndex);
+	this->envoy->envoyLinkControl(&control);
+	this->lastSentTime = millis();
+}
+
+/**
+ * @brief Move to a new stage of negotiation
+ * 
+ * @param stage 
+ */
+void PeripheralLink::changeStage(PeripheralLinkStage stage)
+{
+	this->stage = stage;
+	this->lastStageChangeTime = millis();
+}
+
+/**
+ * @brief Have both boards switch to a candidate rate and begin testing it
+ * 
+ * @param rateIndex 
+ */
+void PeripheralLink::tryRate(uint8_t rateIndex)
+{
+	if (rateIndex == LINK_BAUD_RATE_INDEX_BASE)
+	{
+		this->changeStage(PeripheralLinkStage::Settled);
+		return;
+	}
+
+	this->send(LinkOperation::Switch, rateIndex);
+	this->comms->setBaud(linkBaudRate(rateIndex));
+	this->rateIndex = rateIndex;
+	this->numTestsSent = 0;
+	this->numTestEchoesReceived = 0;
+	this->changeStage(PeripheralLinkStage::Testing);
+}
+
+/**
+ * @brief Abandon the candidate rate. The peripheral returns on its own once testing times out.
+ * 
+ */
+void PeripheralLink::retreat(void)
+{
+	this->comms->setBaud(INTERNAL_COMMS_BAUD_RATE);
+	this->rateIndexCeiling = this->rateIndex - 1;
+	this->rateIndex = LINK_BAUD_RATE_INDEX_BASE;
+	this->changeStage(PeripheralLinkStage::Retreating);
+}
+
+/**
+ * @brief Keep the tested rate
+ * 
+ */
+void PeripheralLink::commit(void)
+{
+	this->send(LinkOperation::Heartbeat, this->rateIndex);
+	this->lastHeartbeatEchoTime = millis();
+	this->lastMonitorTime = millis();
+	this->lastNumReceivedFrames = this->comms->getNumReceivedFrames();
+	this->lastNumDroppedFrames = this->comms->getNumDroppedFrames();
+	this->changeStage(PeripheralLinkStage::Committed);
+}
+
+/**
+ * @brief Abandon the committed rate and negotiate again below it. The peripheral returns on its own 
+ * once heartbeats stop arriving intact.
+ * 
+ */
+void PeripheralLink::fallBack(void)
+{
+	this->comms->setBaud(INTERNAL_COMMS_BAUD_RATE);
+	this->rateIndexCeiling = this->rateIndex - 1;
+	this->rateIndex = LINK_BAUD_RATE_INDEX_BASE;
+	this->changeStage(
+		(this->rateIndexCeiling == LINK_BAUD_RATE_INDEX_BASE) ?
+			PeripheralLinkStage::Settled :
+			PeripheralLinkStage::Offering
+	);
+}
+
+/**
+ * @brief Determine if the committed link has degraded over the last monitoring period. A period 
+ * with too few frames to judge is not degraded, as the peripheral may simply have nothing to send. 
+ * Heartbeat echoes going missing is what shows the peripheral has left this rate.
+ * 
+ */
+bool PeripheralLink::isDegraded(void)
+{
+	unsigned long numReceived = this->comms->getNumReceivedFrames();
+	unsigned long numDropped = this->comms->getNumDroppedFrames();
+	unsigned long numReceivedInPeriod = numReceived - this->lastNumReceivedFrames;
+	unsigned long numDroppedInPeriod = numDropped - this->lastNumDroppedFrames;
+	this->lastMonitorTime = millis();
+	this->lastNumReceivedFrames = numReceived;
+	this->lastNumDroppedFrames = numDropped;
+
+	return isLinkDegraded(numReceivedInPeriod, numDroppedInPeriod);
+}
+
+/**
+ * @brief Read input messages for LinkControl type
+ * 
+ */
+void PeripheralLink::checkLinkControl(void)
+{
+	Message message;
+	while (this->read(MessageType::LinkControl, &message) == ControllerMessageQueueOutput::DequeueSuccess)
+	{
+		LinkControl control;
+		LinkControlTranslation.asStruct(&message, &control);
+		this->handleLinkControl(&control);
+	}
+}
+
+/**
+ * @brief Take a LinkControl received from the peripheral board
+ * 
+ * @param control 
+ */
+void PeripheralLink::handleLinkControl(LinkControl* control)
+{
+	switch ((LinkOperation)control->operation)
+	{
+		case LinkOperation::Accept:
+			if (this->stage == PeripheralLinkStage::Offering)
+				this->tryRate(min(this->rateIndexCeiling, control->rateIndex));
+			break;
+
+		case LinkOperation::TestEcho:
+			if (
+				(this->stage == PeripheralLinkStage::Testing) &&
+				(control->rateIndex == this->rateIndex) &&
+				isLinkTestPatternIntact(control->pattern)
+			)
+				this->numTestEchoesReceived++;
+			break;
+
+		case LinkOperation::HeartbeatEcho:
+			if (
+				(this->stage == PeripheralLinkStage::Committed) &&
+				(control->rateIndex == this->rateIndex)
+			)
+				this->lastHeartbeatEchoTime = millis();
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+ * @brief Advance negotiation, or monitor the committed link
+ * 
+ */
+void PeripheralLink::process(void)
+{
+	this->checkLinkControl();
+
+	time_ms now = millis();
+	time_ms timeInStage = now - this->lastStageChangeTime;
+
+	switch (this->stage)
+	{
+		case PeripheralLinkStage::Offering:
+			if ((now - this->lastSentTime) > LINK_OFFER_PERIOD)
+				this->send(LinkOperation::Offer, this->rateIndexCeiling);
+			break;
+
+		case PeripheralLinkStage::Testing:
+			if (this->numTestEchoesReceived >= LINK_TEST_NUM_EXCHANGES_TO_PASS)
+				this->commit();
+			else if ((now - this->lastSentTime) <= LINK_TEST_PERIOD)
+				break;
+			else if (this->numTestsSent < LINK_TEST_NUM_EXCHANGES)
+			{
+				this->send(LinkOperation::Test, this->rateIndex);
+				this->numTestsSent++;
+			}
+			else
+			{
+				// Last echo has had time to arrive
+				this->retreat();
+			}
+			break;
+
+		case PeripheralLinkStage::Retreating:
+			// Peripheral is back at the base rate once its own test has timed out
+			if (timeInStage > LINK_TEST_TIMEOUT)
+				this->tryRate(this->rateIndexCeiling);
+			break;
+
+		case PeripheralLinkStage::Committed:
+			// Peripheral has stopped answering heartbeats
+			if ((now - this->lastHeartbeatEchoTime) > LINK_HEARTBEAT_TIMEOUT)
+			{
+				this->fallBack();
+				break;
+			}
+			if ((now - this->lastMonitorTime) > LINK_MONITOR_PERIOD)
+			{
+				if (this->isDegraded())
+				{
+					this->fallBack();
+					break;
+				}
+			}
+			if ((now - this->lastSentTime) > LINK_HEARTBEAT_PERIOD)
+				this->send(LinkOperation::Heartbeat, this->rateIndex);
+			break;
+
+		case PeripheralLinkStage::Settled:
+		default:
+			break;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Types.h"
+#include <CommsInterface.h>
+#include <Controller.h>
+#include <LinkDefs.h>
+#include "PeripheralEnvoy.h"
+
+/*****************************************************
+ *                INPUT / OUTPUT TYPES               *
+ *****************************************************/
+using MessageTypesInPeripheralLink = MessageTypes<
+    Fifo<MessageType::LinkControl> // Negotiation responses from peripheral board
+>;
+using MessageTypesOutPeripheralLink = MessageTypes<>;
+
+/*****************************************************
+ *                     CONTROLLER                    *
+ *****************************************************/
+/**
+ * @brief Stage of baud rate negotiation. The controller board leads, the peripheral follows.
+ * 
+ */
+enum class PeripheralLinkStage {
+	Offering, // at INTERNAL_COMMS_BAUD_RATE, offering fastest rate until accepted
+	Testing, // at a candidate rate, exchanging test patterns
+	Retreating, // back at INTERNAL_COMMS_BAUD_RATE, waiting for the peripheral to follow
+	Committed, // at a tested rate, sending heartbeats and hearing their echoes
+	Settled, // nothing faster than INTERNAL_COMMS_BAUD_RATE remains to try
+};
+
+/**
+ * @brief Negotiate the fastest reliable baud rate with the peripheral board. Both boards start at 
+ * INTERNAL_COMMS_BAUD_RATE. Rates are tried fastest first, and each must pass a test pattern 
+ * exchange before it is committed. If a committed rate degrades, both boards fall back and 
+ * negotiation resumes below that rate.
+ * 
+ */
+class PeripheralLink : public Controller<
+	MessageTypesInPeripheralLink, 
+	MessageTypesOutPeripheralLink
+>
+{
+private:
+	CommsInterface* comms;
+	PeripheralEnvoy* envoy;
+
+	/**
+	 * Negotiation state
+	 */
+	PeripheralLinkStage stage;
+	uint8_t rateIndexCeiling; // fastest rate still worth trying
+	uint8_t rateIndex; // rate in use or under test
+	time_ms lastStageChangeTime;
+	time_ms lastSentTime;
+	uint8_t numTestsSent;
+	uint8_t numTestEchoesReceived;
+	time_ms lastHeartbeatEchoTime;
+
+	/**
+	 * Link monitoring
+	 */
+	time_ms lastMonitorTime;
+	unsigned long lastNumReceivedFrames;
+	unsigned long lastNumDroppedFrames;
+
+	void checkLinkControl(void);
+	void handleLinkControl(LinkControl* control);
+	void send(LinkOperation operation, uint8_t rateIndex);
+	void changeStage(PeripheralLinkStage stage);
+	void tryRate(uint8_t rateIndex);
+	void retreat(void);
+	void commit(void);
+	void fallBack(void);
+	bool isDegraded(void);
+public:
+	PeripheralLink(CommsInterface* comms, PeripheralEnvoy* envoy);
+	void process(void);
+};
@@ -61,22 +61,25 @@ void UltrasonicController::checkUltrasonicState(void)
 			// Reject
 			this->sendUltrasonicState(UltrasonicState::Rejected);
 		}
-
-		// Eliminate stale requests
-		this->purge(MessageType::UltrasonicState);
 	}
 }
 
 /**
- * @brief Read input messages for DrivetrainEncoderDistances type
+ * @brief Read input messages for DrivetrainEncoderDistances type, or DrivetrainEncoderTicks if 
+ * DRIVETRAIN_WILL_SEND_FIXED_POINT
  * 
  */
 void UltrasonicController::checkDrivetrainEncoderDistances(void)
 {
     // Dequeue DrivetrainEncoderDistances
 	Message message;
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+	ControllerMessageQueueOutput ret = \
+		this->read(MessageType::DrivetrainEncoderTicks, &message);
+#else
 	ControllerMessageQueueOutput ret = \
 		this->read(MessageType::DrivetrainEncoderDistances, &message);
+#endif
     
     if (ret == ControllerMessageQueueOutput::DequeueSuccess)
 	{
@@ -88,7 +91,13 @@ void UltrasonicController::checkDrivetrainEncoderDistances(void)
         {
             // Unpack information
             DrivetrainEncoderDistances reading;
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+            DrivetrainEncoderTicks ticks;
+            DrivetrainEncoderTicksTranslation.asStruct(&message, &ticks);
+            encoderDistancesFromTicks(&reading, &ticks);
+#else
             DrivetrainEncoderDistancesTranslation.asStruct(&message, &reading);
+#endif
 
             // If this is the first encoder reading, store it as the start
             if (this->sweepState == UltrasonicSweepState::FirstEncoderReading)
@@ -103,9 +112,6 @@ void UltrasonicController::checkDrivetrainEncoderDistances(void)
             // Mark that encoder ping is now outdated
             this->hasPingedEncodersAtThisPosition = false;
         }
-
-        // Eliminate stale values
-		this->purge(MessageType::DrivetrainEncoderDistances);
     }
 }
 
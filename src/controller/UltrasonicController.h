@@ -10,13 +10,17 @@
  *                INPUT / OUTPUT TYPES               *
  *****************************************************/
 using MessageTypesInUltrasonic = MessageTypes<
-    MessageType::UltrasonicState, // Request for ultrasonic ping
-    MessageType::DrivetrainEncoderDistances, // For determining current heading
-    MessageType::DrivetrainAutomatedResponse // for determin
+    Mailbox<MessageType::UltrasonicState>, // Request for ultrasonic ping
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+    Mailbox<MessageType::DrivetrainEncoderTicks>, // For determining current heading
+#else
+    Mailbox<MessageType::DrivetrainEncoderDistances>, // For determining current heading
+#endif
+    Fifo<MessageType::DrivetrainAutomatedResponse> // for determin
 >;
 using MessageTypesOutUltrasonic = MessageTypes<
-    MessageType::UltrasonicPointReading, // Single Ultrasonic point reading from Ultrasonic 1
-	MessageType::UltrasonicState // Indicates if read successful/failure and when sent
+    Fifo<MessageType::UltrasonicPointReading>, // Single Ultrasonic point reading from Ultrasonic 1
+	Fifo<MessageType::UltrasonicState> // Indicates if read successful/failure and when sent
 >;
 
 /*****************************************************
@@ -41,9 +41,6 @@ DrivetrainManualCommand DriveController::getDrivetrainManualCommand(void)
 	if (ret == ControllerMessageQueueOutput::DequeueSuccess)
 	{
 		received = DrivetrainManualCommandTranslation.asEnum(&message);
-
-		// Purge stale messages
-		this->purge(MessageType::DrivetrainManualCommand);
 	}
 	return received;
 }
@@ -51,7 +48,7 @@ DrivetrainManualCommand DriveController::getDrivetrainManualCommand(void)
 /**
  * @brief Read input messages for DrivetrainAutomatedCommand type.
  *  If no automated command is in progress, store the new command and flag it as
- *  unaddressed. On any received command, purge the queue to eliminate stale messages.
+ *  unaddressed. Only the latest command is held, so none are stale.
  * 
  * @return DrivetrainAutomatedCommands received command
  */
@@ -73,9 +70,6 @@ void DriveController::checkDrivetrainAutomatedCommand(void)
 			);
 			this->hasUnaddressedAutomatedCommand = true;
 		}
-
-		// Purge stale commands
-		this->purge(MessageType::DrivetrainAutomatedCommand);
 	}
 }
 
@@ -104,26 +98,38 @@ void DriveController::sendDrivetrainAutomatedResponse(DrivetrainAutomatedRespons
 }
 
 /**
- * @brief Write DrivetrainDisplacements
+ * @brief Write DrivetrainDisplacements, in fixed point if DRIVETRAIN_WILL_SEND_FIXED_POINT
  * 
  * @param response To write
  */
 void DriveController::sendDrivetrainDisplacements(DrivetrainDisplacements *displacements)
 {
 	Message message;
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+	DrivetrainDisplacementsFixed fixed;
+	displacementsFixedFromDisplacements(&fixed, displacements);
+	DrivetrainDisplacementsFixedTranslation.asMessage(&fixed, &message);
+#else
 	DrivetrainDisplacementsTranslation.asMessage(displacements, &message);
+#endif
 	this->post(&message);
 }
 
 /**
- * @brief Write DrivetrainMotorCommand
+ * @brief Write DrivetrainMotorCommand, in fixed point if DRIVETRAIN_WILL_SEND_FIXED_POINT
  * 
  * @param response To write
  */
 void DriveController::sendDrivetrainMotorCommand(DrivetrainMotorCommand *command)
 {
 	Message message;
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+	DrivetrainMotorCommandFixed fixed;
+	motorCommandFixedFromMotorCommand(&fixed, command);
+	DrivetrainMotorCommandFixedTranslation.asMessage(&fixed, &message);
+#else
 	DrivetrainMotorCommandTranslation.asMessage(command, &message);
+#endif
 	this->post(&message);
 }
 
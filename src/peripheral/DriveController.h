@@ -10,12 +10,19 @@
  *                INPUT / OUTPUT TYPES               *
  *****************************************************/
 using MessageTypesInDrive = MessageTypes<
-    MessageType::DrivetrainManualCommand, // Manual commands
-    MessageType::DrivetrainAutomatedCommand // Automated commands
+    Mailbox<MessageType::DrivetrainManualCommand>, // Manual commands
+    Mailbox<MessageType::DrivetrainAutomatedCommand> // Automated commands
 >;
 using MessageTypesOutDrive = MessageTypes<
-    MessageType::DrivetrainManualResponse, // Manual command responses
-    MessageType::DrivetrainAutomatedResponse // Automated command responses
+    Weighted<Fifo<MessageType::DrivetrainManualResponse>, 2>, // Manual command responses
+    Weighted<Fifo<MessageType::DrivetrainAutomatedResponse>, 2>, // Automated command responses
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+    Fifo<MessageType::DrivetrainDisplacementsFixed>, // Net displacements of a command
+    Mailbox<MessageType::DrivetrainMotorCommandFixed> // Latest automated motor command
+#else
+    Fifo<MessageType::DrivetrainDisplacements>, // Net displacements of a command
+    Mailbox<MessageType::DrivetrainMotorCommand> // Latest automated motor command
+#endif
 >;
 
 /*****************************************************
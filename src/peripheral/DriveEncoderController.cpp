@@ -28,12 +28,23 @@ void DriveEncoderController::checkDrivetrainEncoderState(void)
 		DrivetrainEncoderState state = DrivetrainEncoderStateTranslation.asEnum(&message);
 		if (state == DrivetrainEncoderState::Request)
 			this->hasUnaddressedRequest = true;
-
-		// Eliminate stale messages
-		this->purge(MessageType::DrivetrainEncoderState);
 	}
 }
 
+/**
+ * @brief Ping drivetrain for present encoder values, as raw ticks
+ * 
+ * @param ticks 
+ */
+void DriveEncoderController::getDrivetrainEncoderTicks(DrivetrainEncoderTicks* ticks)
+{
+	long distance1, distance2, distance3;
+	this->drivetrainEncoders->getCurrentDistances(&distance1, &distance2, &distance3);
+	ticks->encoder1Ticks = (int32_t)distance1;
+	ticks->encoder2Ticks = (int32_t)distance2;
+	ticks->encoder3Ticks = (int32_t)distance3;
+}
+
 /**
  * @brief Ping drivetrain for present encoder values and convert to appropriate distances
  * 
@@ -41,24 +52,28 @@ void DriveEncoderController::checkDrivetrainEncoderState(void)
  */
 void DriveEncoderController::getDrivetrainEncoderDistances(DrivetrainEncoderDistances* distances)
 {
-	long distance1, distance2, distance3;
-	this->drivetrainEncoders->getCurrentDistances(&distance1, &distance2, &distance3);
-	distances->encoder1Dist = (encoderDistance_in)distance1 * ENCODER_1_TO_IN;
-	distances->encoder2Dist = (encoderDistance_in)distance2 * ENCODER_2_TO_IN;
-	distances->encoder3Dist = (encoderDistance_in)distance3 * ENCODER_3_TO_IN;
+	DrivetrainEncoderTicks ticks;
+	this->getDrivetrainEncoderTicks(&ticks);
+	encoderDistancesFromTicks(distances, &ticks);
 }
 
 /**
- * @brief Send current drivetrain encoder distances
+ * @brief Send current drivetrain encoder distances. Sent as raw ticks if 
+ * DRIVETRAIN_WILL_SEND_FIXED_POINT, so no float math is spent on them.
  * 
  */
 void DriveEncoderController::sendDrivetrainEncoderDistances(void)
 {
+	Message message;
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+	DrivetrainEncoderTicks ticks;
+	this->getDrivetrainEncoderTicks(&ticks);
+	DrivetrainEncoderTicksTranslation.asMessage(&ticks, &message);
+#else
 	DrivetrainEncoderDistances distances;
 	this->getDrivetrainEncoderDistances(&distances);
-
-	Message message;
 	DrivetrainEncoderDistancesTranslation.asMessage(&distances, &message);
+#endif
 	ControllerMessageQueueOutput result = this->post(&message);
 
 	if (result == ControllerMessageQueueOutput::EnqueueSuccess)
@@ -8,10 +8,14 @@
  *                INPUT / OUTPUT TYPES               *
  *****************************************************/
 using MessageTypesInDriveEncoder = MessageTypes<
-    MessageType::DrivetrainEncoderState // Request an encoder reading
+    Mailbox<MessageType::DrivetrainEncoderState> // Request an encoder reading
 >;
 using MessageTypesOutDriveEncoder = MessageTypes<
-    MessageType::DrivetrainEncoderDistances // Encoder reading
+#if DRIVETRAIN_WILL_SEND_FIXED_POINT
+    Fifo<MessageType::DrivetrainEncoderTicks> // Encoder reading, scaled by receiver
+#else
+    Fifo<MessageType::DrivetrainEncoderDistances> // Encoder reading
+#endif
 >;
 
 /*****************************************************
@@ -47,6 +51,7 @@ private:
 	bool shouldSend(void);
 public:
 	DriveEncoderController(DrivetrainEncoders* drivetrainEncoders);
+	void getDrivetrainEncoderTicks(DrivetrainEncoderTicks* ticks);
 	void getDrivetrainEncoderDistances(DrivetrainEncoderDistances* distances);
 	void process(void);
 };
\ No newline at end of file
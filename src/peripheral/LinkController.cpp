@@ -0,0 +1,168 @@
+#include "LinkController.h"
+#include "Settings.h"
+#include <Translate.h>
+
+/**
+ * @brief Construct a new LinkController
+ * 
+ * @param comms Interface to the controller board
+ */
+LinkController::LinkController(CommsInterface* comms) :
+	comms(comms),
+	stage(LinkStage::Base),
+	rateIndex(LINK_BAUD_RATE_INDEX_BASE),
+	lastStageChangeTime(0),
+	lastHeartbeatTime(0),
+	lastMonitorTime(0),
+	lastNumReceivedFrames(0),
+	lastNumDroppedFrames(0) {}
+
+/**
+ * @brief Read input messages for LinkControl type
+ * 
+ */
+void LinkController::checkLinkControl(void)
+{
+	Message message;
+	while (this->read(MessageType::LinkControl, &message) == ControllerMessageQueueOutput::DequeueSuccess)
+	{
+		LinkControl control;
+		LinkControlTranslation.asStruct(&message, &control);
+		this->handleLinkControl(&control);
+	}
+}
+
+/**
+ * @brief Send a LinkControl to the controller board
+ * 
+ * @param operation 
+ * @param rateIndex 
+ */
+void LinkController::sendLinkControl(LinkOperation operation, uint8_t rateIndex)
+{
+	LinkControl control;
+	fillLinkControl(&control, operation, rateIndex);
+
+	Message message;
+	LinkControlTranslation.asMessage(&control, &message);
+	this->post(&message);
+}
+
+/**
+ * @brief Respond to one step of negotiation
+ * 
+ * @param control 
+ */
+void LinkController::handleLinkControl(LinkControl* control)
+{
+	switch ((LinkOperation)control->operation)
+	{
+		case LinkOperation::Offer:
+			// Agree on the fastest rate both boards support
+			this->sendLinkControl(
+				LinkOperation::Accept,
+				min((uint8_t)LINK_BAUD_RATE_INDEX_MAX, control->rateIndex)
+			);
+			break;
+
+		case LinkOperation::Switch:
+			if (control->rateIndex <= LINK_BAUD_RATE_INDEX_MAX)
+				this->switchRate(control->rateIndex, LinkStage::Testing);
+			break;
+
+		case LinkOperation::Test:
+			if (
+				(this->stage == LinkStage::Testing) &&
+				(control->rateIndex == this->rateIndex) &&
+				isLinkTestPatternIntact(control->pattern)
+			)
+				this->sendLinkControl(LinkOperation::TestEcho, this->rateIndex);
+			break;
+
+		case LinkOperation::Heartbeat:
+			// First heartbeat at a tested rate commits it, and every heartbeat is answered so the 
+			// controller board hears from an otherwise idle link
+			if (control->rateIndex != this->rateIndex) break;
+			if (this->stage == LinkStage::Testing)
+			{
+				this->stage = LinkStage::Committed;
+				this->lastMonitorTime = millis();
+				this->lastNumReceivedFrames = this->comms->getNumReceivedFrames();
+				this->lastNumDroppedFrames = this->comms->getNumDroppedFrames();
+			}
+			this->lastHeartbeatTime = millis();
+			this->sendLinkControl(LinkOperation::HeartbeatEcho, this->rateIndex);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+ * @brief Change the rate of the link
+ * 
+ * @param rateIndex 
+ * @param stage Stage at new rate
+ */
+void LinkController::switchRate(uint8_t rateIndex, LinkStage stage)
+{
+	this->comms->setBaud(linkBaudRate(rateIndex));
+	this->rateIndex = rateIndex;
+	this->stage = stage;
+	this->lastStageChangeTime = millis();
+}
+
+/**
+ * @brief Determine if the link should fall back to the base rate. The controller board will notice 
+ * the peripheral has gone quiet and renegotiate.
+ * 
+ */
+bool LinkController::shouldFallBack(void)
+{
+	time_ms now = millis();
+	switch (this->stage)
+	{
+		case LinkStage::Testing:
+			// Controller board never committed
+			return (now - this->lastStageChangeTime) > LINK_TEST_TIMEOUT;
+
+		case LinkStage::Committed:
+		{
+			// Controller board has gone quiet
+			if ((now - this->lastHeartbeatTime) > LINK_HEARTBEAT_TIMEOUT)
+				return true;
+
+			if ((now - this->lastMonitorTime) < LINK_MONITOR_PERIOD)
+				return false;
+
+			// Too many damaged frames over the last period
+			unsigned long numReceived = this->comms->getNumReceivedFrames();
+			unsigned long numDropped = this->comms->getNumDroppedFrames();
+			bool isDegraded = isLinkDegraded(
+				numReceived - this->lastNumReceivedFrames,
+				numDropped - this->lastNumDroppedFrames
+			);
+			this->lastMonitorTime = now;
+			this->lastNumReceivedFrames = numReceived;
+			this->lastNumDroppedFrames = numDropped;
+			return isDegraded;
+		}
+
+		case LinkStage::Base:
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief Follow baud rate negotiation and fall back if the link degrades
+ * 
+ */
+void LinkController::process(void)
+{
+	this->checkLinkControl();
+
+	if (this->shouldFallBack())
+		this->switchRate(LINK_BAUD_RATE_INDEX_BASE, LinkStage::Base);
+}
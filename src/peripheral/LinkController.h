@@ -0,0 +1,71 @@
+#pragma once
+#include "Types.h"
+#include <CommsInterface.h>
+#include <Controller.h>
+#include <LinkDefs.h>
+
+/*****************************************************
+ *                INPUT / OUTPUT TYPES               *
+ *****************************************************/
+using MessageTypesInLink = MessageTypes<
+    Fifo<MessageType::LinkControl> // Negotiation from controller board
+>;
+using MessageTypesOutLink = MessageTypes<
+    Fifo<MessageType::LinkControl> // Negotiation responses
+>;
+
+/*****************************************************
+ *                     CONTROLLER                    *
+ *****************************************************/
+/**
+ * @brief Stage of baud rate negotiation. The controller board leads, the peripheral follows.
+ * 
+ */
+enum class LinkStage {
+	Base, // at INTERNAL_COMMS_BAUD_RATE
+	Testing, // at a new rate, awaiting first heartbeat to commit
+	Committed, // at a new rate, kept alive by heartbeats
+};
+
+class LinkController : public Controller<
+	MessageTypesInLink, 
+	MessageTypesOutLink
+>
+{
+private:
+	/**
+	 * Reference to the interface whose rate is negotiated
+	 */
+	CommsInterface* comms;
+
+	/**
+	 * Negotiation state
+	 */
+	LinkStage stage;
+	uint8_t rateIndex;
+	time_ms lastStageChangeTime;
+	time_ms lastHeartbeatTime;
+
+	/**
+	 * Link monitoring
+	 */
+	time_ms lastMonitorTime;
+	unsigned long lastNumReceivedFrames;
+	unsigned long lastNumDroppedFrames;
+
+	/**
+	 * @brief Communication utilities
+	 */
+	void checkLinkControl(void);
+	void sendLinkControl(LinkOperation operation, uint8_t rateIndex);
+
+	/**
+	 * @brief Process utilities
+	 */
+	void handleLinkControl(LinkControl* control);
+	void switchRate(uint8_t rateIndex, LinkStage stage);
+	bool shouldFallBack(void);
+public:
+	LinkController(CommsInterface* comms);
+	void process(void);
+};
@@ -3,8 +3,10 @@
 #include <Wiring.h>
 #include <CommsInterface.h>
 #include <Taskmaster.h>
+#include <DiagnosticsController.h>
 #include "DriveController.h"
 #include "DriveEncoderController.h"
+#include "LinkController.h"
 #include "Settings.h"
 #include "Errors.h"
 #include "Translate.h"
@@ -21,15 +23,27 @@ static DrivetrainEncoders g_drivetrainEncoders;
 static DriveEncoderController g_driveEncoderController(&g_drivetrainEncoders);
 Drivetrain g_drivetrain;
 DriveController g_driveController(&g_drivetrain, &g_driveEncoderController);
+static LinkController g_linkController(&g_controllerComms);
+static DiagnosticsController g_diagnosticsController;
 
 /*****************************************************
  *                    TASKMASTERS                    *
  *****************************************************/
 static ControllerGeneric* controllers[] = {
 	&g_driveController,
-	&g_driveEncoderController
+	&g_driveEncoderController,
+	&g_linkController,
+	&g_diagnosticsController
 };
-TASKMASTER_DECLARE(taskmaster, &g_controllerComms, controllers)
+static CommsInterface* ports[] = {
+	&g_controllerComms // Controller board, and the host beyond it
+};
+static const uint8_t addressRoutes[BOARD_ADDRESS_COUNT] = {
+	0, // BOARD_ADDRESS_HOST
+	0, // BOARD_ADDRESS_CONTROLLER
+	TASKMASTER_ROUTE_SELF // BOARD_ADDRESS_PERIPHERAL
+};
+TASKMASTER_DECLARE(taskmaster, ports, addressRoutes, controllers)
 
 /**
  * @brief Global setup functions for board
@@ -40,6 +54,9 @@ void setup()
 	Wiring_InitComms(&g_controllerComms);
 	Wiring_InitDrivetrainEncoders(&g_drivetrainEncoders);
 	Wiring_InitDrivetrain(&g_drivetrain);
+
+	// Controllers reporting on the Taskmaster
+	g_diagnosticsController.init(&taskmaster);
 }
 
 /**
@@ -0,0 +1,240 @@
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "Arduino.h"
+
+/*****************************************************
+ *                       CORE                        *
+ *****************************************************/
+static unsigned long long monotonicMicros(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long)now.tv_sec * 1000000ULL + (unsigned long long)now.tv_nsec / 1000ULL;
+}
+
+static const unsigned long long startTime_us = monotonicMicros();
+
+unsigned long micros(void)
+{
+	return (unsigned long)(monotonicMicros() - startTime_us);
+}
+
+unsigned long millis(void)
+{
+	return (unsigned long)((monotonicMicros() - startTime_us) / 1000ULL);
+}
+
+void delay(unsigned long ms)
+{
+	usleep(ms * 1000UL);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+	usleep(us);
+}
+
+/**
+ * Pins have no effect on the host, so writes are logged for tests to check
+ */
+static uint8_t pinValues[256];
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+	(void)pin;
+	(void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+	pinValues[pin] = value;
+	printf("%lu pin %u %u\n", millis(), pin, value);
+	fflush(stdout);
+}
+
+int digitalRead(uint8_t pin)
+{
+	return pinValues[pin];
+}
+
+/*****************************************************
+ *                   SERIAL PORTS                    *
+ *****************************************************/
+HardwareSerial Serial("Serial");
+HardwareSerial Serial1("Serial1");
+HardwareSerial Serial2("Serial2");
+HardwareSerial Serial3("Serial3");
+
+/**
+ * @brief Get the tty speed standing in for a baud rate. Rates without a termios constant, such as
+ * 250000, take the nearest one below, so both ends of a pty at the same rate still match.
+ *
+ * @param baud
+ * @return speed_t
+ */
+static speed_t ttySpeedOf(unsigned long baud)
+{
+	if (baud >= 230400) return B230400;
+	if (baud >= 115200) return B115200;
+	if (baud >= 57600) return B57600;
+	if (baud >= 38400) return B38400;
+	if (baud >= 19200) return B19200;
+	return B9600;
+}
+
+HardwareSerial::HardwareSerial(const char* name) :
+	name(name),
+	fd(-1),
+	baud(0),
+	isOpen(false),
+	numTransmitBytesPending(0),
+	lastDrainTime_us(0),
+	peeked(-1) {}
+
+/**
+ * @brief Back the port with a tty. Unattached ports discard what is written and never receive.
+ *
+ * @param path Such as the slave end of a pty
+ */
+void HardwareSerial::attach(const char* path)
+{
+	this->fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (this->fd < 0)
+	{
+		perror(path);
+		exit(1);
+	}
+	this->applyBaud();
+}
+
+/**
+ * @brief Set the tty raw at the current rate
+ *
+ */
+void HardwareSerial::applyBaud(void)
+{
+	if (this->fd < 0) return;
+
+	struct termios attributes;
+	if (tcgetattr(this->fd, &attributes) != 0) return;
+	cfmakeraw(&attributes);
+	cfsetispeed(&attributes, ttySpeedOf(this->baud));
+	cfsetospeed(&attributes, ttySpeedOf(this->baud));
+	tcsetattr(this->fd, TCSANOW, &attributes);
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+	this->baud = baud;
+	this->isOpen = true;
+	this->numTransmitBytesPending = 0;
+	this->lastDrainTime_us = micros();
+	this->applyBaud();
+
+	printf("%lu %s begin %lu\n", millis(), this->name, baud);
+	fflush(stdout);
+}
+
+/**
+ * @brief Close the port. Received bytes not yet read are discarded, as the AVR core does.
+ *
+ */
+void HardwareSerial::end(void)
+{
+	this->flush();
+	this->isOpen = false;
+	this->peeked = -1;
+	if (this->fd >= 0)
+		tcflush(this->fd, TCIFLUSH);
+}
+
+/**
+ * @brief Drain the modelled transmit buffer by the time passed, at ten bits per byte
+ *
+ */
+void HardwareSerial::drain(void)
+{
+	unsigned long now = micros();
+	double numDrained = (double)(now - this->lastDrainTime_us) * (double)this->baud / 10e6;
+	this->lastDrainTime_us = now;
+	this->numTransmitBytesPending = (numDrained >= this->numTransmitBytesPending) ?
+		0 :
+		(this->numTransmitBytesPending - numDrained);
+}
+
+int HardwareSerial::available(void)
+{
+	if ((this->fd < 0) || !this->isOpen) return 0;
+
+	int numBytes = 0;
+	if (ioctl(this->fd, FIONREAD, &numBytes) != 0) return 0;
+	return numBytes + ((this->peeked >= 0) ? 1 : 0);
+}
+
+int HardwareSerial::peek(void)
+{
+	if (this->peeked < 0)
+		this->peeked = this->read();
+	return this->peeked;
+}
+
+int HardwareSerial::read(void)
+{
+	if (this->peeked >= 0)
+	{
+		int byte = this->peeked;
+		this->peeked = -1;
+		return byte;
+	}
+	if ((this->fd < 0) || !this->isOpen) return -1;
+
+	uint8_t byte;
+	return (::read(this->fd, &byte, 1) == 1) ? byte : -1;
+}
+
+int HardwareSerial::availableForWrite(void)
+{
+	this->drain();
+	return SERIAL_TX_BUFFER_SIZE - 1 - (int)ceil(this->numTransmitBytesPending);
+}
+
+/**
+ * @brief Write a byte, busy-waiting while the modelled transmit buffer is full
+ *
+ */
+size_t HardwareSerial::write(uint8_t byte)
+{
+	if (!this->isOpen) return 0;
+	while (this->availableForWrite() <= 0)
+		;
+	this->numTransmitBytesPending += 1;
+
+	if (this->fd >= 0)
+	{
+		while (::write(this->fd, &byte, 1) != 1)
+			usleep(100);
+	}
+	return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		this->write(buffer[i]);
+	return size;
+}
+
+/**
+ * @brief Wait until every byte written has left the modelled transmit buffer
+ *
+ */
+void HardwareSerial::flush(void)
+{
+	if (!this->isOpen) return;
+	do
+		this->drain();
+	while (this->numTransmitBytesPending > 0);
+}
@@ -0,0 +1,104 @@
+#pragma once
+/**
+ * Host stand-in for the parts of the Arduino core the boards' communications use, so their comms,
+ * Taskmaster and controllers run on a PC. Each HardwareSerial is backed by a tty, normally one end
+ * of a pty pair, and begin() sets the tty's speed so the other end can see the rate in use.
+ * Writes block once the modelled 64 byte transmit buffer is full, as on the boards.
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*****************************************************
+ *                       CORE                        *
+ *****************************************************/
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define CHANGE 1
+#define PI 3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+/*****************************************************
+ *                      PROGMEM                      *
+ *****************************************************/
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define strcmp_P strcmp
+#define strncpy_P strncpy
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+/*****************************************************
+ *                   SERIAL PORTS                    *
+ *****************************************************/
+#define SERIAL_TX_BUFFER_SIZE 64
+
+class HardwareSerial
+{
+private:
+	const char* name;
+	int fd;
+	unsigned long baud;
+	bool isOpen;
+
+	/**
+	 * Modelled transmit buffer, drained at the current rate
+	 */
+	double numTransmitBytesPending;
+	unsigned long lastDrainTime_us;
+
+	int peeked;
+
+	void drain(void);
+	void applyBaud(void);
+public:
+	HardwareSerial(const char* name);
+	void attach(const char* path);
+	void begin(unsigned long baud);
+	void begin(unsigned long baud, uint8_t config) { (void)config; this->begin(baud); }
+	void end(void);
+	unsigned long getBaud(void) const { return this->baud; }
+	int available(void);
+	int peek(void);
+	int read(void);
+	int availableForWrite(void);
+	size_t write(uint8_t byte);
+	size_t write(const uint8_t* buffer, size_t size);
+	size_t write(const char* buffer, size_t size) { return this->write((const uint8_t*)buffer, size); }
+	size_t print(const char* string) { return this->write(string, strlen(string)); }
+	size_t println(const char* string) { return this->print(string) + this->print("\r\n"); }
+	void flush(void);
+	operator bool(void) { return true; }
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+extern HardwareSerial Serial3;
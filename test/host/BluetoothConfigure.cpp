@@ -0,0 +1,33 @@
+/**
+ * The controller board's Bluetooth module startup on the host: Bluetooth::configure run against
+ * whatever answers on a tty, normally a test's scripted module on the other end of a pty. EEPROM
+ * is the file named by HOST_EEPROM_PATH. Build with -DBOARD_CONTROLLER, see
+ * python/tests/host_build.py.
+ *
+ * Usage: BluetoothConfigure <tty> <baud>
+ *
+ * Prints "configured <baud>" with the rate configure returns. KEY pin writes are printed by the
+ * digitalWrite stand-in, as "<ms> pin <pin> <value>".
+ */
+#include <Arduino.h>
+#include <Bluetooth.h>
+#include "Settings.h"
+
+#define HOST_PIN_BLUETOOTH_KEY (7)
+
+static Bluetooth g_bluetooth;
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: %s <tty> <baud>\n", argv[0]);
+		return 2;
+	}
+	Serial.attach(argv[1]);
+	unsigned long baud = strtoul(argv[2], NULL, 10);
+
+	g_bluetooth.init(&Serial, HOST_PIN_BLUETOOTH_KEY);
+	printf("configured %lu\n", g_bluetooth.configure(baud));
+	return 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+/**
+ * Host stand-in for the EEPROM library, backed by the file named by HOST_EEPROM_PATH so it persists
+ * across runs. Bytes never written read as 0xFF, as erased EEPROM does.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+class EEPROMClass
+{
+private:
+	static const char* path(void)
+	{
+		const char* path = getenv("HOST_EEPROM_PATH");
+		return (path != NULL) ? path : "eeprom.bin";
+	}
+
+public:
+	template <typename T>
+	T& get(int address, T& value)
+	{
+		memset(&value, 0xFF, sizeof(T));
+		FILE* file = fopen(path(), "rb");
+		if (file == NULL) return value;
+		if (fseek(file, address, SEEK_SET) == 0)
+		{
+			uint8_t bytes[sizeof(T)];
+			size_t numRead = fread(bytes, 1, sizeof(T), file);
+			memcpy(&value, bytes, numRead);
+		}
+		fclose(file);
+		return value;
+	}
+
+	template <typename T>
+	const T& put(int address, const T& value)
+	{
+		FILE* file = fopen(path(), "r+b");
+		if (file == NULL) file = fopen(path(), "w+b");
+		if (file == NULL) return value;
+
+		// Pad up to address with erased bytes
+		fseek(file, 0, SEEK_END);
+		for (long size = ftell(file); size < address; size++)
+			fputc(0xFF, file);
+		fseek(file, address, SEEK_SET);
+		fwrite(&value, 1, sizeof(T), file);
+		fclose(file);
+		return value;
+	}
+};
+
+static EEPROMClass EEPROM;
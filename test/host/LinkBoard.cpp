@@ -0,0 +1,89 @@
+/**
+ * One board's end of the internal link, run on the host: its CommsInterface, Taskmaster and link
+ * negotiation controller, with the link UART backed by a tty. Build with -DBOARD_CONTROLLER or
+ * -DBOARD_PERIPHERAL, see python/tests/host_build.py.
+ *
+ * Usage: LinkBoard <tty> <duration ms>
+ *
+ * Every change of rate is printed by the Serial stand-in, as "<ms> Serial1 begin <baud>".
+ */
+#include <Arduino.h>
+#include <CommsInterface.h>
+#include <Taskmaster.h>
+#include "Settings.h"
+
+#if defined(BOARD_CONTROLLER)
+#include "PeripheralEnvoy.h"
+#include "PeripheralLink.h"
+
+#define LINK_PORT (&Serial1)
+
+static CommsInterface g_externalComms;
+static CommsInterface g_peripheralComms;
+static PeripheralEnvoy g_envoyToPeripheral(&g_peripheralComms);
+static PeripheralLink g_peripheralLink(&g_peripheralComms, &g_envoyToPeripheral);
+
+static CommsInterface* ports[] = {
+	&g_externalComms, // Host, not attached
+	&g_peripheralComms // Peripheral board
+};
+static const uint8_t addressRoutes[BOARD_ADDRESS_COUNT] = {
+	0, // BOARD_ADDRESS_HOST
+	TASKMASTER_ROUTE_SELF, // BOARD_ADDRESS_CONTROLLER
+	1 // BOARD_ADDRESS_PERIPHERAL
+};
+static ControllerGeneric* controllers[] = {
+	&g_peripheralLink
+};
+
+static void initComms(void)
+{
+	g_externalComms.init(&Serial, EXTERNAL_COMMS_BAUD_RATE);
+	g_peripheralComms.init(LINK_PORT, INTERNAL_COMMS_BAUD_RATE);
+}
+#elif defined(BOARD_PERIPHERAL)
+#include "LinkController.h"
+
+#define LINK_PORT (&Serial)
+
+static CommsInterface g_controllerComms;
+static LinkController g_linkController(&g_controllerComms);
+
+static CommsInterface* ports[] = {
+	&g_controllerComms // Controller board, and the host beyond it
+};
+static const uint8_t addressRoutes[BOARD_ADDRESS_COUNT] = {
+	0, // BOARD_ADDRESS_HOST
+	0, // BOARD_ADDRESS_CONTROLLER
+	TASKMASTER_ROUTE_SELF // BOARD_ADDRESS_PERIPHERAL
+};
+static ControllerGeneric* controllers[] = {
+	&g_linkController
+};
+
+static void initComms(void)
+{
+	g_controllerComms.init(LINK_PORT, INTERNAL_COMMS_BAUD_RATE);
+}
+#endif
+
+TASKMASTER_DECLARE(taskmaster, ports, addressRoutes, controllers)
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: %s <tty> <duration ms>\n", argv[0]);
+		return 2;
+	}
+	LINK_PORT->attach(argv[1]);
+	unsigned long duration = strtoul(argv[2], NULL, 10);
+
+	initComms();
+	while (millis() < duration)
+	{
+		taskmaster.execute();
+		delayMicroseconds(200);
+	}
+	return 0;
+}
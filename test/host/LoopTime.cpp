@@ -0,0 +1,123 @@
+/**
+ * The controller board's main loop on the host, timed into a LoopTimeHistogram while a controller
+ * dumps a full lidar sweep of LidarPointReading frames toward the host every DUMP_PERIOD. Build
+ * with -DBOARD_CONTROLLER, see python/tests/host_build.py.
+ *
+ * Usage: LoopTime <tty> <baud> <duration ms> <queued|blocking>
+ *
+ * queued runs the Taskmaster as the board does: frames are collected within the byte budget into
+ * the transmit buffer, and the port drains it between loops. blocking models the transmit path
+ * before: every frame of the dump is collected in the loop it appears, and written through the
+ * port, which waits whenever its 64 byte buffer is full.
+ *
+ * The histogram is printed at the end, one "<bucket> <count>" line per bucket then "max <us>".
+ */
+#include <Arduino.h>
+#include <CommsInterface.h>
+#include <Controller.h>
+#include <Taskmaster.h>
+#include <DiagnosticsDefs.h>
+#include "Settings.h"
+
+#define DUMP_PERIOD (2000) // millis
+#define DUMP_NUM_POINTS (LIDAR_GRANULARITY_NUM_POINTS)
+#define LOOP_WORK_TIME (200) // micros, stand-in for the rest of the board's loop
+
+/**
+ * Streams a sweep of point readings, as the lidar did before scan chunks
+ */
+class DumpController : public Controller<MessageTypes<>, MessageTypes<>>
+{
+private:
+	time_ms lastDumpTime;
+	uint16_t numPointsRemaining;
+public:
+	DumpController(void) : lastDumpTime(0), numPointsRemaining(0) {}
+
+	bool isDumping(void) { return this->numPointsRemaining > 0; }
+
+	void process(void)
+	{
+		if ((false == this->isDumping()) && ((millis() - this->lastDumpTime) > DUMP_PERIOD))
+		{
+			this->numPointsRemaining = DUMP_NUM_POINTS;
+			this->lastDumpTime = millis();
+		}
+	}
+
+	size_t stream(FrameWriter* writer, size_t numBytesBudget)
+	{
+		size_t numBytesWritten = 0;
+		while ((numBytesWritten < numBytesBudget) && this->isDumping())
+		{
+			int16_t point[2] = {(int16_t)(DUMP_NUM_POINTS - this->numPointsRemaining), 1000};
+			if (false == writer->begin(MessageType::LidarPointReading, sizeof(point)))
+				break;
+			writer->write((const char*)point, sizeof(point));
+			numBytesWritten += writer->end();
+			this->numPointsRemaining--;
+		}
+		return numBytesWritten;
+	}
+};
+
+static CommsInterface g_externalComms;
+static DumpController g_dumpController;
+
+static CommsInterface* ports[] = {
+	&g_externalComms // Host
+};
+static const uint8_t addressRoutes[BOARD_ADDRESS_COUNT] = {
+	0, // BOARD_ADDRESS_HOST
+	TASKMASTER_ROUTE_SELF, // BOARD_ADDRESS_CONTROLLER
+	TASKMASTER_ROUTE_SELF // BOARD_ADDRESS_PERIPHERAL
+};
+static ControllerGeneric* controllers[] = {
+	&g_dumpController
+};
+TASKMASTER_DECLARE(taskmaster, ports, addressRoutes, controllers)
+
+/**
+ * @brief Collect and write the rest of the dump, waiting on the port as it fills
+ *
+ */
+static void sendDumpBlocking(void)
+{
+	while (g_dumpController.isDumping())
+	{
+		g_dumpController.stream(g_externalComms.getFrameWriter(), g_externalComms.getNumFreeTransmitBytes());
+		g_externalComms.flushTransmit();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 5)
+	{
+		fprintf(stderr, "Usage: %s <tty> <baud> <duration ms> <queued|blocking>\n", argv[0]);
+		return 2;
+	}
+	Serial.attach(argv[1]);
+	unsigned long baud = strtoul(argv[2], NULL, 10);
+	unsigned long duration = strtoul(argv[3], NULL, 10);
+	bool isBlocking = (strcmp(argv[4], "blocking") == 0);
+
+	LoopTimeHistogram loopTimes = {{0}, 0};
+	g_externalComms.init(&Serial, baud);
+	while (millis() < duration)
+	{
+		time_us loopStartTime = micros();
+
+		taskmaster.execute();
+		if (isBlocking)
+			sendDumpBlocking();
+		delayMicroseconds(LOOP_WORK_TIME);
+
+		recordLoopTime(&loopTimes, micros() - loopStartTime);
+	}
+
+	for (uint8_t bucket = 0; bucket < LOOP_TIME_HISTOGRAM_NUM_BUCKETS; bucket++)
+		printf("%u %u\n", bucket, loopTimes.count[bucket]);
+	printf("max %lu\n", (unsigned long)loopTimes.maxLoopTime_us);
+	return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * Host microbenchmark of MessageQueueHub at 2, 5 and 10 queued types. Each round enqueues,
+ * dequeues, enqueues and clears the last type, whose lookup is the longest for a fold. The fold
+ * over every allowed type that the hub used before its dense index is timed beside it, as the
+ * same queueSlotOf evaluated at runtime. Build with -DBOARD_CONTROLLER, see
+ * python/tests/host_build.py.
+ *
+ * Usage: QueueHubBench [rounds]
+ *
+ * Prints "<types> <fold lookup ns> <index lookup ns> <round ns>" per hub. Host timings only show
+ * the relative cost; the boards are far slower per operation.
+ */
+#include <Arduino.h>
+#include <MessageQueueHub.h>
+#include <time.h>
+
+#define BENCH_TYPE(i) ((MessageType)(1 + (i)))
+
+static double nowNs(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/**
+ * Defeats constant folding of the type looked up
+ */
+static volatile uint8_t g_lookupType;
+static volatile uint32_t g_sink;
+
+template <typename... specs>
+static void bench(unsigned long numRounds)
+{
+	static MessageQueueHub<specs...> hub;
+	const uint8_t numTypes = sizeof...(specs);
+	g_lookupType = (uint8_t)BENCH_TYPE(numTypes - 1);
+
+	// Lookup by a fold over every allowed type, as before
+	double start = nowNs();
+	for (unsigned long i = 0; i < numRounds; i++)
+		g_sink += queueSlotOf((MessageType)g_lookupType, 0, specs::type...);
+	double foldNs = (nowNs() - start) / numRounds;
+
+	// Lookup by the dense index
+	start = nowNs();
+	for (unsigned long i = 0; i < numRounds; i++)
+		g_sink += hub.locateSlotByType((MessageType)g_lookupType);
+	double indexNs = (nowNs() - start) / numRounds;
+
+	// Round of queue operations on the last type
+	Message message;
+	char content[4] = {1, 2, 3, 4};
+	message.init((MessageType)g_lookupType, sizeof(content), content);
+	Message out;
+	start = nowNs();
+	for (unsigned long i = 0; i < numRounds; i++)
+	{
+		g_sink += hub.enqueue(&message);
+		g_sink += hub.dequeue((MessageType)g_lookupType, &out);
+		g_sink += hub.enqueue(&message);
+		g_sink += hub.clear((MessageType)g_lookupType);
+	}
+	double roundNs = (nowNs() - start) / numRounds;
+
+	printf("%u %.1f %.1f %.1f\n", numTypes, foldNs, indexNs, roundNs);
+}
+
+int main(int argc, char** argv)
+{
+	unsigned long numRounds = (argc > 1) ? strtoul(argv[1], NULL, 10) : 2000000UL;
+
+	bench<Fifo<BENCH_TYPE(0)>, Fifo<BENCH_TYPE(1)>>(numRounds);
+	bench<
+		Fifo<BENCH_TYPE(0)>, Fifo<BENCH_TYPE(1)>, Fifo<BENCH_TYPE(2)>, Fifo<BENCH_TYPE(3)>,
+		Fifo<BENCH_TYPE(4)>
+	>(numRounds);
+	bench<
+		Fifo<BENCH_TYPE(0)>, Fifo<BENCH_TYPE(1)>, Fifo<BENCH_TYPE(2)>, Fifo<BENCH_TYPE(3)>,
+		Fifo<BENCH_TYPE(4)>, Fifo<BENCH_TYPE(5)>, Fifo<BENCH_TYPE(6)>, Fifo<BENCH_TYPE(7)>,
+		Fifo<BENCH_TYPE(8)>, Fifo<BENCH_TYPE(9)>
+	>(numRounds);
+	return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * Weighted pickup on the host: a controller keeps two Response types weighted 3 and 1 queued,
+ * while a Control type is posted now and then and a Bulk type waits behind them all. The
+ * Taskmaster collects toward a port whose transmit rate limits how much leaves per loop, so the
+ * Response types compete for it. Build with -DBOARD_CONTROLLER, see python/tests/host_build.py.
+ *
+ * Usage: WeightedPickup <baud> <duration ms>
+ *
+ * Prints "<type> <count>" with the messages of each type collected.
+ */
+#include <Arduino.h>
+#include <CommsInterface.h>
+#include <Controller.h>
+#include <Taskmaster.h>
+#include <Translate.h>
+#include "Settings.h"
+
+#define CONTROL_POST_PERIOD (20) // millis
+#define QUEUE_DEPTH (3)
+
+using MessageTypesOutWeighted = MessageTypes<
+	Fifo<MessageType::DrivetrainManualResponse>, // Control
+	Weighted<Fifo<MessageType::DrivetrainDisplacements, QUEUE_DEPTH>, 3>, // Response
+	Weighted<Fifo<MessageType::DrivetrainEncoderDistances, QUEUE_DEPTH>, 1>, // Response
+	Fifo<MessageType::DrivetrainMotorCommand, QUEUE_DEPTH> // Bulk
+>;
+
+/**
+ * Refills its output queues every loop, so each message posted after the first fill replaces one
+ * collected
+ */
+class WeightedController : public Controller<MessageTypes<>, MessageTypesOutWeighted>
+{
+private:
+	time_ms lastControlPostTime;
+	bool isFilled;
+
+	/**
+	 * @brief Post messages of a type until its queue is full
+	 *
+	 * @return Number of messages posted
+	 */
+	unsigned long fill(MessageType type, uint8_t size)
+	{
+		char content[MESSAGE_CONTENT_LENGTH_MAX] = {0};
+		Message message;
+		message.init(type, size, content);
+
+		unsigned long numPosted = 0;
+		while (this->post(&message) == ControllerMessageQueueOutput::EnqueueSuccess)
+			numPosted++;
+		return numPosted;
+	}
+public:
+	unsigned long numHeavy;
+	unsigned long numLight;
+	unsigned long numBulk;
+
+	WeightedController(void) :
+		lastControlPostTime(0), isFilled(false), numHeavy(0), numLight(0), numBulk(0) {}
+
+	void process(void)
+	{
+		if ((millis() - this->lastControlPostTime) > CONTROL_POST_PERIOD)
+		{
+			Message message;
+			DrivetrainManualResponseTranslation.asMessage(DrivetrainManualResponse::Acknowledge, &message);
+			this->post(&message);
+			this->lastControlPostTime = millis();
+		}
+
+		unsigned long numHeavy = this->fill(MessageType::DrivetrainDisplacements, sizeof(DrivetrainDisplacements));
+		unsigned long numLight = this->fill(MessageType::DrivetrainEncoderDistances, sizeof(DrivetrainEncoderDistances));
+		unsigned long numBulk = this->fill(MessageType::DrivetrainMotorCommand, sizeof(DrivetrainMotorCommand));
+		if (this->isFilled)
+		{
+			this->numHeavy += numHeavy;
+			this->numLight += numLight;
+			this->numBulk += numBulk;
+		}
+		this->isFilled = true;
+	}
+};
+
+static CommsInterface g_externalComms;
+static WeightedController g_weightedController;
+
+static CommsInterface* ports[] = {
+	&g_externalComms // Host
+};
+static const uint8_t addressRoutes[BOARD_ADDRESS_COUNT] = {
+	0, // BOARD_ADDRESS_HOST
+	TASKMASTER_ROUTE_SELF, // BOARD_ADDRESS_CONTROLLER
+	TASKMASTER_ROUTE_SELF // BOARD_ADDRESS_PERIPHERAL
+};
+static ControllerGeneric* controllers[] = {
+	&g_weightedController
+};
+TASKMASTER_DECLARE(taskmaster, ports, addressRoutes, controllers)
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "Usage: %s <baud> <duration ms>\n", argv[0]);
+		return 2;
+	}
+	unsigned long baud = strtoul(argv[1], NULL, 10);
+	unsigned long duration = strtoul(argv[2], NULL, 10);
+
+	// Unattached, so frames are discarded once the modelled port drains them
+	g_externalComms.init(&Serial, baud);
+	while (millis() < duration)
+		taskmaster.execute();
+
+	printf("heavy %lu\n", g_weightedController.numHeavy);
+	printf("light %lu\n", g_weightedController.numLight);
+	printf("bulk %lu\n", g_weightedController.numBulk);
+	return 0;
+}